@@ -0,0 +1,72 @@
+/**
+ * @file adc_noise_bench.cpp
+ *
+ * @brief Noise on a photodiode reading against how many readings a second it allows.
+ *
+ * The top left photodiode sits at a fixed ADC_LEVEL, dim light, with ADC_NOISE counts of noise on
+ * every conversion and CPU_NOISE more while the CPU runs through it (both std-dev, the middle of
+ * what a breadboarded Nano shows on AVcc). For each count of extra bits it takes READS readings
+ * with readOversampledCounts() and reports:
+ *
+ *     conversions    per reading, 4^extra bits
+ *     reads/s        readings a second of simulated time, on that one photodiode
+ *     noise counts   std-dev of the readings, scaled back to 10 bit counts
+ *     free bits      noise-free resolution, log2(1024 / (6.6 x std-dev))
+ *
+ * Built twice by `make adc-noise`: once as is, and once with ADC_NOISE_SLEEP defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+
+#define ADC_LEVEL 120
+#define ADC_NOISE 0.5
+#define CPU_NOISE 1.5
+#define READS 4000
+
+// Peak to peak is about 6.6 std-devs
+#define PEAK_TO_PEAK_SIGMAS 6.6
+
+static void runExtraBits(uint8_t extraBits) {
+	simReset();
+	sim.analog[PHOTODIODE_TOP_LEFT] = ADC_LEVEL;
+	sim.adcNoise = ADC_NOISE;
+	sim.adcCpuNoise = CPU_NOISE;
+
+	double sum = 0;
+	double sumSquares = 0;
+	uint64_t startUs = sim.timeUs;
+
+	for (int i = 0; i < READS; i++) {
+		double counts = (double) readOversampledCounts(PHOTODIODE_TOP_LEFT, extraBits) / (1 << extraBits);
+		sum += counts;
+		sumSquares += counts * counts;
+	}
+
+	double seconds = (sim.timeUs - startUs) / 1e6;
+	double mean = sum / READS;
+	double sigma = sqrt(sumSquares / READS - mean * mean);
+
+	printf("%-6u %11u %10.0f %12.3f %10.1f\n", extraBits, 1 << (2 * extraBits), READS / seconds,
+			sigma, log2(SENSOR_MAX_OUT / (PEAK_TO_PEAK_SIGMAS * sigma)));
+}
+
+int main() {
+#ifdef ADC_NOISE_SLEEP
+	printf("ADC conversions: in noise reduction sleep\n");
+#else
+	printf("ADC conversions: analogRead()\n");
+#endif
+
+	printf("%-6s %11s %10s %12s %10s\n", "extra", "conversions", "reads/s", "noise counts", "free bits");
+	for (uint8_t extraBits = 0; extraBits <= OVERSAMPLE_MAX_EXTRA_BITS; extraBits++)
+		runExtraBits(extraBits);
+	return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file battery_bench.cpp
+ *
+ * @brief Drives the robot at the same speed setting on batteries at different points of discharge.
+ *
+ * For each battery voltage the robot drives straight at MEDIUM with the light dead ahead, and
+ * the cruise speed, the PWM actually written, the governor's power mode and its runtime
+ * estimate are reported. The spread of the cruise speeds down to BATTERY_REDUCED_VOLTS shows
+ * how well the compensation holds the speed.
+ *
+ * Built twice by `make battery`: once as is, and once with BATTERY_NO_COMPENSATION defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+#include "world.h"
+
+#define WARMUP_US 3000000
+#define CRUISE_US 2000000
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+extern float batteryVoltage;
+
+/*
+ * @brief How the robot drove on one battery
+ */
+struct batteryResult {
+	double cruiseCmps;
+	int pwm;
+	uint16_t runtimeMinutes;
+	uint8_t power;
+};
+
+static void runLoop() {
+	RobotDetection();
+	RobotPlanning();
+	RobotAction();
+}
+
+static batteryResult runBattery(double volts) {
+	simReset();
+	worldReset();
+	world.robot.batteryVolts = volts;
+	world.robot.supplyVolts = volts;
+	world.drivePhotodiodes = false;
+	sim.analog[PHOTODIODE_TOP_LEFT] = 700;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = 700;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = 700;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = 700;
+	sim.capTau = 50;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	batteryVoltage = 0;
+	robotSpeed = MEDIUM;
+	initPins();
+	initServo();
+	setMotorBalance(0);
+
+	while (sim.timeUs < WARMUP_US)
+		runLoop();
+
+	double startCm = world.distanceCm;
+	uint64_t startUs = sim.timeUs;
+	while (sim.timeUs < startUs + CRUISE_US)
+		runLoop();
+
+	double seconds = (sim.timeUs - startUs) / 1e6;
+	return {(world.distanceCm - startCm) / seconds, sim.pwm[MOTOR_LEFT], batteryRuntimeMinutes(), actionStates.Power};
+}
+
+int main() {
+	const double voltages[] = {9.3, 8.7, 8.1, 7.5, 7.2, 6.9, 6.7, 6.5};
+	const int count = sizeof(voltages) / sizeof(voltages[0]);
+
+#ifdef BATTERY_NO_COMPENSATION
+	printf("Battery compensation: off\n");
+#else
+	printf("Battery compensation: scaled to %.1f V\n", BATTERY_NOMINAL_VOLTS);
+#endif
+	printf("%-9s %10s %6s %12s %8s\n", "battery V", "cm/s", "pwm", "runtime min", "power");
+
+	double slowest = 0, fastest = 0;
+	for (int i = 0; i < count; i++) {
+		batteryResult result = runBattery(voltages[i]);
+		printf("%-9.1f %10.1f %6d %12u %8s\n", voltages[i], result.cruiseCmps, result.pwm,
+				result.runtimeMinutes, result.power == POWER_REDUCED ? "reduced" : "normal");
+
+		if (result.power == POWER_REDUCED)
+			continue;
+		if (i == 0 || result.cruiseCmps < slowest)
+			slowest = result.cruiseCmps;
+		if (i == 0 || result.cruiseCmps > fastest)
+			fastest = result.cruiseCmps;
+	}
+
+	printf("Speed spread in normal power: %.1f cm/s (%.0f%% of the fastest)\n", fastest - slowest,
+			100 * (fastest - slowest) / fastest);
+	return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file boot_bench.cpp
+ *
+ * @brief Boot time and EEPROM wear of the calibration store.
+ *
+ * Boots the sketch, setup() and then one pass of loop(), from each of these EEPROM states:
+ *
+ *     erased    nothing stored yet, runs on the defaults
+ *     stored    one good record
+ *     corrupt   the newest record was cut short, the one before it is used
+ *     stale     only a record from another layout version, runs on the defaults
+ *
+ * and checks the right calibration was applied and the first pass of loop() finished within
+ * BOOT_BUDGET_MS of power on. The Arduino core's init() and the bootloader aren't counted.
+ *
+ * Then it saves a new servo rest angle every CAL_SAVE_INTERVAL_MS for WEAR_SAVES saves and
+ * reports how many times the busiest EEPROM cell was written.
+ *
+ * Exits non-zero if any boot is over budget or loads the wrong calibration.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "includes.h"
+#include "../lightTrackingRobot.ino"
+
+#define ADC_BRIGHT 700
+#define CAP_UNTOUCHED 50
+#define WEAR_SAVES 10000
+#define EEPROM_ENDURANCE 100000.0
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+enum bootType {BOOT_ERASED, BOOT_STORED, BOOT_CORRUPT, BOOT_STALE, NUM_BOOTS};
+
+static const char* bootNames[NUM_BOOTS] = {"erased", "stored", "corrupt", "stale"};
+
+static const calibrationStruct defaults = DEFAULT_CALIBRATION_STRUCT;
+
+// Recognisably different from the defaults
+static calibrationStruct storedRecord(uint8_t servoStart) {
+	calibrationStruct record = DEFAULT_CALIBRATION_STRUCT;
+	record.motorBalance = -12;
+	record.servoStart = servoStart;
+	record.sonarOffsetCm = 2;
+	return record;
+}
+
+static void powerOn() {
+	simReset();
+	sim.capTau = CAP_UNTOUCHED;
+	sim.sonarCm = 0;
+	sim.analog[PHOTODIODE_TOP_LEFT] = ADC_BRIGHT;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = ADC_BRIGHT;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = ADC_BRIGHT;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = ADC_BRIGHT;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = ROBOT_START_SPEED;
+}
+
+static void save(const calibrationStruct& record) {
+	calibration = record;
+	saveCalibration();
+}
+
+// Leaves the EEPROM as the boot type describes, returns the calibration that should load
+static calibrationStruct prepare(bootType type) {
+	simEraseEeprom();
+	powerOn();
+	loadCalibration();
+
+	switch (type) {
+		case BOOT_ERASED:
+			return defaults;
+		case BOOT_STORED:
+			save(storedRecord(130));
+			return storedRecord(130);
+		case BOOT_CORRUPT: {
+			save(storedRecord(130));
+			save(storedRecord(120));
+			// Power lost while writing the last byte of the newest record
+			simEeprom[CAL_EEPROM_BASE + CAL_SLOT_SIZE + sizeof(calibrationStruct) - 1] ^= 0x5A;
+			return storedRecord(130);
+		}
+		case BOOT_STALE:
+			save(storedRecord(130));
+			simEeprom[CAL_EEPROM_BASE + offsetof(calibrationStruct, version)] = CAL_VERSION + 1;
+			return defaults;
+		default:
+			return defaults;
+	}
+}
+
+static bool sameCalibration(const calibrationStruct& a, const calibrationStruct& b) {
+	return a.motorBalance == b.motorBalance && a.servoStart == b.servoStart
+		&& a.servoMin == b.servoMin && a.servoMax == b.servoMax
+		&& a.sonarOffsetCm == b.sonarOffsetCm && a.capThreshold == b.capThreshold;
+}
+
+static bool runBoot(bootType type) {
+	calibrationStruct expected = prepare(type);
+
+	// The load on its own
+	powerOn();
+	bool loaded = loadCalibration();
+	uint64_t loadUs = sim.timeUs;
+
+	powerOn();
+	setup();
+	uint64_t setupUs = sim.timeUs;
+	loop();
+	uint64_t bootUs = sim.timeUs;
+
+	bool correct = sameCalibration(calibration, expected)
+		&& motorBalance() == expected.motorBalance
+		&& sim.servoPulseUs == servoAngleToPulse(expected.servoStart);
+	bool inBudget = bootUs <= BOOT_BUDGET_MS * 1000ULL;
+
+	printf("%-8s %-9s balance %4d  servo %3d  load %5.2f ms  setup %5.2f ms  first loop %6.2f ms  %s\n",
+			bootNames[type], loaded ? "stored" : "defaults", calibration.motorBalance,
+			calibration.servoStart, loadUs / 1000.0, setupUs / 1000.0, bootUs / 1000.0,
+			!correct ? "WRONG CALIBRATION" : inBudget ? "ok" : "OVER BUDGET");
+	return correct && inBudget;
+}
+
+static void runWear() {
+	simEraseEeprom();
+	powerOn();
+	loadCalibration();
+
+	uint64_t saveUs = 0;
+	for (int i = 0; i < WEAR_SAVES; i++) {
+		simAdvance(CAL_SAVE_INTERVAL_MS * 1000UL);
+		uint64_t start = sim.timeUs;
+		saveServoRest((i % 2) ? SERVO_ANGLE_START - 20 : SERVO_ANGLE_START - 10);
+		saveUs += sim.timeUs - start;
+	}
+
+	uint32_t busiest = 0;
+	for (int cell = 0; cell < SIM_EEPROM_SIZE; cell++) {
+		if (simEepromWrites[cell] > busiest)
+			busiest = simEepromWrites[cell];
+	}
+
+	double lifeSaves = EEPROM_ENDURANCE * WEAR_SAVES / busiest;
+	printf("\n%d saves over %d slots: busiest cell written %u times, %.1f ms a save\n",
+			WEAR_SAVES, CAL_SLOTS, busiest, saveUs / 1000.0 / WEAR_SAVES);
+	printf("endurance %.0f saves, %.0f days of saving every %d s\n",
+			lifeSaves, lifeSaves * CAL_SAVE_INTERVAL_MS / 1000.0 / 86400.0, CAL_SAVE_INTERVAL_MS / 1000);
+
+	// Check a reboot after all that still finds the newest record
+	powerOn();
+	loadCalibration();
+	printf("reloaded sequence %u, servo %d\n", calibration.sequence, calibration.servoStart);
+}
+
+int main() {
+	bool ok = true;
+
+	printf("boot budget %d ms\n\n", BOOT_BUDGET_MS);
+	for (int type = 0; type < NUM_BOOTS; type++)
+		ok &= runBoot((bootType) type);
+
+	runWear();
+	return ok ? 0 : 1;
+}
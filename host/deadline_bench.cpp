@@ -0,0 +1,338 @@
+/**
+ * @file deadline_bench.cpp
+ *
+ * @brief Per-phase latency of loop() against its budgets, and the watchdog safe stop on a hang.
+ *
+ * Boots the sketch, setup() then loop(), in the telemetry profile, the one with the longest
+ * action phase, and drives towards a light drifting across its path for RUN_S simulated seconds.
+ * Reports each phase's budget, runs, longest run and overruns from the deadline monitor, and
+ * checks the watchdog never fired.
+ *
+ * Then for HANG_TRIALS trials it boots again and hangs the sketch at a random time: whatever
+ * hardware call the clock is in at that moment never returns. For each phase a hang landed in it
+ * reports how many trials
+ *
+ *     stopped    had both wheels stopped by the watchdog interrupt
+ *     reset      were reset by the watchdog
+ *     reported   sent the phase that hung in the reset frame after booting again
+ *
+ * and the mean and longest time from the hang to the wheels stopping and to the reset. Planning
+ * makes no hardware calls, so no hang lands in it.
+ *
+ * Last, for SLOW_TRIALS trials it boots again and from a random time holds the capacitive sensor at
+ * SLOW_CAP_TAU, which slows every sample down. Every pass runs over budget but loop() keeps going,
+ * so it still drives the motors between the watchdog interrupt stopping them and the reset.
+ * Reports how many trials were stopped and reset, the passes run in between, and in how many of
+ * them a wheel was turning again.
+ *
+ * Exits non-zero if the watchdog fires while running normally, a hang isn't stopped, reset and
+ * reported with the right phase, or a slow loop isn't reset within SLOW_MAX_MS or starts a wheel
+ * again after the stop.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <random>
+
+#include "includes.h"
+#include "frame_decoder.h"
+#include "world.h"
+#include "../lightTrackingRobot.ino"
+
+#define RUN_S 60
+#define HANG_TRIALS 200
+#define HANG_MIN_MS 200
+#define HANG_MAX_MS 3000
+#define HANG_STEP_US 100
+#define REPORT_WAIT_MS 1000
+#define CAP_UNTOUCHED 50
+#define LIGHT_START_CM 300
+#define LIGHT_HEIGHT_CM 80		// straight ahead of the array at SERVO_ANGLE_START
+#define LIGHT_DRIFT_CMPS 5
+#define SLOW_TRIALS 50
+#define SLOW_CAP_TAU 80000		// each capacitive sample takes 40 ms, over the detection budget
+#define SLOW_MAX_MS 5000
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+static const char* phaseNames[NUM_PHASES] = {"detection", "planning", "action"};
+
+static jmp_buf resetJump;
+
+static struct {
+	uint8_t frame[1 + DATA_BLOB_DATA_SIZE];
+	int length;
+	uint32_t deadlineFrames;
+	bool resetSeen;
+	deadlineRecordStruct reset;
+} link;
+
+/*
+ * @brief What happened to one phase's hangs
+ */
+struct phaseHangs {
+	uint32_t trials;
+	uint32_t stopped;
+	uint32_t reset;
+	uint32_t reported;
+	double stopMsTotal;
+	double stopMsMax;
+	double resetMsTotal;
+	double resetMsMax;
+};
+
+static struct {
+	uint8_t phase;
+	uint64_t hangUs;
+	uint64_t stoppedUs;
+} trial;
+
+static void decodeFrame() {
+	if (link.frame[0] == DEADLINE_DATA_BLOB_HEADER)
+		link.deadlineFrames++;
+	if (link.frame[0] != DEADLINE_RESET_DATA_BLOB_HEADER)
+		return;
+
+	link.resetSeen = true;
+	link.reset.phase = link.frame[1];
+	memcpy(&link.reset.atMs, &link.frame[2], sizeof(link.reset.atMs));
+	memcpy(&link.reset.phaseMs, &link.frame[6], sizeof(link.reset.phaseMs));
+	link.reset.resets = link.frame[8];
+}
+
+static void onSerial(uint8_t byte, uint64_t timeUs) {
+	(void) timeUs;
+
+	// Waiting for a header
+	if (link.length == 0 && framePayloadLength(byte) == 0)
+		return;
+
+	link.frame[link.length++] = byte;
+	if (link.length == 1 + framePayloadLength(link.frame[0])) {
+		decodeFrame();
+		link.length = 0;
+	}
+}
+
+static void onWatchdogReset() {
+	longjmp(resetJump, 1);
+}
+
+// Power on, or coming out of a reset: only the .noinit record and the EEPROM carry over
+static void boot() {
+	simReset();
+	worldReset();
+	world.light = {LIGHT_START_CM, -LIGHT_DRIFT_CMPS * RUN_S / 2.0, LIGHT_HEIGHT_CM, 0, LIGHT_DRIFT_CMPS, true};
+	sim.capTau = CAP_UNTOUCHED;
+	sim.onSerial = onSerial;
+	sim.onWatchdogReset = onWatchdogReset;
+	link.length = 0;
+	link.resetSeen = false;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = ROBOT_START_SPEED;
+	setup();
+}
+
+// loop() runs back to back, so the phase running is the first that's a pass behind detection
+static uint8_t phaseRunning() {
+	uint32_t passes = phaseStats[PHASE_DETECTION].runs;
+
+	for (uint8_t phase = PHASE_PLANNING; phase < NUM_PHASES; phase++) {
+		if (phaseStats[phase].runs < passes)
+			return phase;
+	}
+	return PHASE_DETECTION;
+}
+
+static bool wheelStopped(uint8_t pin) {
+	double hz, duty;
+
+	if (simPwmWaveform(pin, &hz, &duty))
+		return duty == 0;
+	return sim.digitalOut[pin] == LOW;
+}
+
+// Never returns, the watchdog reset jumps out of it
+static void hang() {
+	trial.phase = phaseRunning();
+	trial.hangUs = sim.timeUs;
+	trial.stoppedUs = 0;
+
+	while (true) {
+		simAdvance(HANG_STEP_US);
+		simSyncOutputs();
+		if (!trial.stoppedUs && wheelStopped(MOTOR_LEFT) && wheelStopped(MOTOR_RIGHT))
+			trial.stoppedUs = sim.timeUs;
+	}
+}
+
+// Unlike hang(), every pass of loop() overruns but the sketch keeps running
+static void slowDown() {
+	sim.capTau = SLOW_CAP_TAU;
+}
+
+static bool runNormally() {
+	if (setjmp(resetJump)) {
+		printf("deadline_bench: the watchdog reset the robot while running normally\n");
+		return false;
+	}
+
+	simEraseEeprom();
+	boot();
+	uint64_t endUs = sim.timeUs + RUN_S * 1000000ULL;
+	while (sim.timeUs < endUs)
+		loop();
+
+	printf("%-10s %10s %10s %10s %10s\n", "phase", "budget us", "runs", "max us", "overruns");
+	for (uint8_t phase = 0; phase < NUM_PHASES; phase++) {
+		printf("%-10s %10lu %10lu %10lu %10u\n", phaseNames[phase], (unsigned long) phaseBudgetUs[phase],
+				(unsigned long) phaseStats[phase].runs, (unsigned long) phaseStats[phase].maxUs,
+				phaseStats[phase].overruns);
+	}
+	printf("%d s driving: %lu watchdog resets, %lu latency frames\n\n", RUN_S,
+			(unsigned long) sim.watchdogResets, (unsigned long) link.deadlineFrames);
+	return sim.watchdogResets == 0;
+}
+
+static bool runTrial(std::mt19937& rng, uint32_t resetsSoFar, phaseHangs* hangs) {
+	std::uniform_int_distribution<uint32_t> hangMs(HANG_MIN_MS, HANG_MAX_MS);
+
+	if (setjmp(resetJump) == 0) {
+		boot();
+		simSchedule(sim.timeUs + hangMs(rng) * 1000ULL, hang);
+		while (true)
+			loop();
+	}
+
+	// Out of the watchdog reset
+	phaseHangs* hung = &hangs[trial.phase];
+	double resetMs = (sim.timeUs - trial.hangUs) / 1000.0;
+	hung->trials++;
+	hung->reset++;
+	hung->resetMsTotal += resetMs;
+	hung->resetMsMax = std::max(hung->resetMsMax, resetMs);
+	if (trial.stoppedUs) {
+		double stopMs = (trial.stoppedUs - trial.hangUs) / 1000.0;
+		hung->stopped++;
+		hung->stopMsTotal += stopMs;
+		hung->stopMsMax = std::max(hung->stopMsMax, stopMs);
+	}
+
+	if (setjmp(resetJump)) {
+		printf("deadline_bench: the watchdog reset the robot again after booting\n");
+		return false;
+	}
+	boot();
+	uint64_t endUs = sim.timeUs + REPORT_WAIT_MS * 1000ULL;
+	while (!link.resetSeen && sim.timeUs < endUs)
+		loop();
+
+	bool reported = link.resetSeen && link.reset.phase == trial.phase && link.reset.resets == resetsSoFar + 1;
+	if (reported)
+		hung->reported++;
+	return trial.stoppedUs && reported;
+}
+
+/*
+ * @brief What happened to the slow loops
+ */
+static struct {
+	uint32_t trials;
+	uint32_t stopped;
+	uint32_t reset;
+	uint32_t passesStopped;		// passes of loop() between the stop and the reset
+	uint32_t passesTurning;		// of those, ones that ended with a wheel turning again
+} slow;
+
+static bool runSlow(std::mt19937& rng) {
+	std::uniform_int_distribution<uint32_t> slowMs(HANG_MIN_MS, HANG_MAX_MS);
+	// Read after the longjmp()
+	volatile bool stopped = false;
+	volatile uint32_t turning = 0;
+
+	slow.trials++;
+	if (setjmp(resetJump) == 0) {
+		boot();
+		uint64_t slowUs = sim.timeUs + slowMs(rng) * 1000ULL;
+		simSchedule(slowUs, slowDown);
+		while (sim.timeUs < slowUs + SLOW_MAX_MS * 1000ULL) {
+			loop();
+			if (deadlineRecord.phase == DEADLINE_PHASE_NONE)
+				continue;
+
+			// The watchdog interrupt has run, the wheels stay stopped until the reset
+			stopped = true;
+			slow.passesStopped++;
+			simSyncOutputs();
+			if (!wheelStopped(MOTOR_LEFT) || !wheelStopped(MOTOR_RIGHT))
+				turning++;
+		}
+		printf("deadline_bench: a slow loop wasn't reset\n");
+		return false;
+	}
+
+	// Out of the watchdog reset
+	slow.reset++;
+	if (stopped)
+		slow.stopped++;
+	slow.passesTurning += turning;
+	return stopped && turning == 0;
+}
+
+int main() {
+	printf("Deadline monitor: watchdog %lu ms, %s profile\n",
+			(unsigned long) (SIM_WATCHDOG_BASE_US << DEADLINE_WATCHDOG_TIMEOUT) / 1000, PROFILE_NAME);
+
+	bool ok = runNormally();
+
+	std::mt19937 rng(240);
+	phaseHangs hangs[NUM_PHASES] = {};
+	for (uint32_t i = 0; i < HANG_TRIALS; i++) {
+		if (!runTrial(rng, i, hangs))
+			ok = false;
+	}
+
+	printf("%-10s %8s %9s %9s %9s %9s %9s %9s %9s\n", "hang in", "trials", "stopped", "reset",
+			"reported", "stop ms", "max", "reset ms", "max");
+	for (uint8_t phase = 0; phase < NUM_PHASES; phase++) {
+		phaseHangs* hung = &hangs[phase];
+		if (!hung->trials) {
+			printf("%-10s %8u\n", phaseNames[phase], 0);
+			continue;
+		}
+		printf("%-10s %8lu %9lu %9lu %9lu %9.1f %9.1f %9.1f %9.1f\n", phaseNames[phase],
+				(unsigned long) hung->trials, (unsigned long) hung->stopped, (unsigned long) hung->reset,
+				(unsigned long) hung->reported, hung->stopMsTotal / std::max(hung->stopped, 1u),
+				hung->stopMsMax, hung->resetMsTotal / hung->reset, hung->resetMsMax);
+	}
+
+	bool slowOk = true;
+	for (uint32_t i = 0; i < SLOW_TRIALS; i++) {
+		if (!runSlow(rng))
+			slowOk = false;
+	}
+
+	printf("\n%-10s %8s %9s %9s %9s %9s\n", "slow loop", "trials", "stopped", "reset", "passes", "turning");
+	printf("%-10s %8lu %9lu %9lu %9lu %9lu\n", "", (unsigned long) slow.trials, (unsigned long) slow.stopped,
+			(unsigned long) slow.reset, (unsigned long) slow.passesStopped, (unsigned long) slow.passesTurning);
+
+	if (!ok) {
+		printf("deadline_bench: a hang wasn't stopped, reset and reported\n");
+		return 1;
+	}
+	if (!slowOk) {
+		printf("deadline_bench: a slow loop drove a wheel again after the watchdog stopped it\n");
+		return 1;
+	}
+	return 0;
+}
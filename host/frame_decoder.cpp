@@ -0,0 +1,101 @@
+/**
+ * @file frame_decoder.cpp
+ *
+ * @brief Implementation of the frame decoder defined in frame_decoder.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <string.h>
+
+#include "frame_decoder.h"
+#include "communicate.h"
+
+static const struct {
+	uint8_t header;
+	uint8_t length;
+} frameLengths[] = {
+	{SENSOR_DATA_BLOB_HEADER, SENSOR_DATA_BLOB_LENGTH},
+	{ACTION_DATA_BLOB_HEADER, ACTION_DATA_BLOB_LENGTH},
+	{PIN_DATA_BLOB_HEADER, PIN_DATA_BLOB_LENGTH},
+	{MEMORY_DATA_BLOB_HEADER, MEMORY_DATA_BLOB_LENGTH},
+	{BATTERY_DATA_BLOB_HEADER, BATTERY_DATA_BLOB_LENGTH},
+	{PROFILER_DATA_BLOB_HEADER, PROFILER_DATA_BLOB_LENGTH},
+	{PIN_SUMMARY_DATA_BLOB_HEADER, PIN_SUMMARY_DATA_BLOB_LENGTH},
+	{PIN_HISTOGRAM_DATA_BLOB_HEADER, PIN_HISTOGRAM_DATA_BLOB_LENGTH},
+	{DEADLINE_DATA_BLOB_HEADER, DEADLINE_DATA_BLOB_LENGTH},
+	{DEADLINE_RESET_DATA_BLOB_HEADER, DEADLINE_RESET_DATA_BLOB_LENGTH},
+};
+
+// Every byte's payload length, so the scan is one load per byte. Filled in when the module
+// loads, before any decode can run on another thread.
+static struct lengthTableStruct {
+	uint8_t length[256];
+
+	lengthTableStruct() : length() {
+		for (const auto& frame : frameLengths)
+			length[frame.header] = frame.length;
+	}
+} lengthTable;
+
+uint8_t framePayloadLength(uint8_t header) {
+	return lengthTable.length[header];
+}
+
+size_t decodeFrames(const uint8_t* data, size_t length, frameColumnsStruct* columns, uint64_t baseOffset) {
+	size_t i = 0;
+	while (i < length) {
+		uint8_t header = data[i];
+		uint8_t payloadLength = lengthTable.length[header];
+
+		// Not a header, keep looking
+		if (payloadLength == 0) {
+			columns->skippedBytes++;
+			i++;
+			continue;
+		}
+
+		// Cut off, leave it for the next buffer
+		if (length - i - 1 < payloadLength)
+			break;
+
+		const uint8_t* payload = data + i + 1;
+		uint64_t offset = baseOffset + i;
+
+		switch (header) {
+			case SENSOR_DATA_BLOB_HEADER:
+				columns->sensor.offset.push_back(offset);
+				columns->sensor.light.push_back(payload[0]);
+				columns->sensor.collision.push_back(payload[1]);
+				columns->sensor.capacitive.push_back(payload[2]);
+				break;
+			case ACTION_DATA_BLOB_HEADER:
+				columns->action.offset.push_back(offset);
+				columns->action.collision.push_back(payload[0]);
+				columns->action.drive.push_back(payload[1]);
+				columns->action.servo.push_back(payload[2]);
+				break;
+			case PIN_DATA_BLOB_HEADER: {
+				// Little endian on the robot and on every host this runs on
+				float voltage;
+				memcpy(&voltage, payload + 1, sizeof(voltage));
+
+				columns->pin.offset.push_back(offset);
+				columns->pin.pin.push_back(payload[0]);
+				columns->pin.voltage.push_back(voltage);
+				break;
+			}
+			default:
+				columns->otherFrames++;
+				break;
+		}
+
+		i += 1 + payloadLength;
+	}
+
+	return i;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file frame_decoder.h
+ *
+ * @brief Decodes whole buffers of telemetry frames into columns, for the Python tooling.
+ *
+ * The robot's frames are a header byte and a fixed length payload, see communicate.h. Bytes that
+ * aren't a known header are dropped until one turns up, the same way read_packet() in
+ * serialComs.py resynchronises, so a capture started mid frame or with noise on the line decodes
+ * the same either way. The state and pin frames are split into one column per field:
+ *
+ *     0xAA sensor   offset, light (bit 0 down, 1 left, 2 right, 3 up), collision, capacitive
+ *     0xBB action   offset, collision, drive, servo
+ *     0xCC pin      offset, pin, voltage
+ *
+ * where offset is the position of the header in the stream. Every other frame is only counted and
+ * stepped over by its length.
+ *
+ * Wrapped for Python by framedecoder_module.cpp, `make frame-decoder` builds it and runs the
+ * throughput bench.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __FRAME_DECODER_H__
+#define __FRAME_DECODER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/*
+ * @brief Decoded frames, one vector per field
+ */
+typedef struct _frameColumnsStruct {
+	struct {
+		std::vector<uint64_t> offset;
+		std::vector<uint8_t> light;
+		std::vector<uint8_t> collision;
+		std::vector<uint8_t> capacitive;
+	} sensor;
+	struct {
+		std::vector<uint64_t> offset;
+		std::vector<uint8_t> collision;
+		std::vector<uint8_t> drive;
+		std::vector<uint8_t> servo;
+	} action;
+	struct {
+		std::vector<uint64_t> offset;
+		std::vector<uint8_t> pin;
+		std::vector<float> voltage;
+	} pin;
+	uint64_t otherFrames;		// known frames stepped over by length
+	uint64_t skippedBytes;		// bytes dropped while looking for a header
+} frameColumnsStruct;
+
+/**
+ * @brief	Payload length after a header byte.
+ *
+ * @param uint8_t header : the byte
+ *
+ * @return The payload length, 0 when the byte isn't a header
+ */
+uint8_t framePayloadLength(uint8_t header);
+
+/**
+ * @brief	Decodes every complete frame in a buffer and appends it to the columns.
+ *
+ * A frame cut off by the end of the buffer is left alone, so a stream can be fed in chunks by
+ * passing the unconsumed tail back in front of the next one.
+ *
+ * @param const uint8_t* data : the bytes
+ * @param size_t length : how many
+ * @param frameColumnsStruct* columns : appended to
+ * @param uint64_t baseOffset : stream position of data[0], for the offset columns
+ *
+ * @return How many bytes were consumed
+ */
+size_t decodeFrames(const uint8_t* data, size_t length, frameColumnsStruct* columns, uint64_t baseOffset);
+
+#endif  // __FRAME_DECODER_H__
@@ -0,0 +1,233 @@
+"""
+@file frame_decoder_bench.py
+
+@brief Throughput of the native frame decoder against the Python decoding in serialComs.py.
+
+Builds a synthetic capture shaped like the telemetry profile's link: a sensor and an action frame
+every pass of loop(), pin frames on some, the occasional memory, battery and pin summary frame,
+and a stray byte now and then to resynchronise over. It is then decoded three ways:
+
+    read_packet            serialComs.read_packet() one frame at a time off a file-like port,
+                           the way the viewer reads, plus the unpack helpers for each field
+    decode_frames_python   the whole buffer in pure Python
+    framedecoder           the whole buffer in one call to the native module
+
+and each reports MB/s and frames/s. All three have to agree on every decoded field, otherwise
+the bench fails.
+
+Usage (`make frame-decoder` builds the module and runs this):
+    PYTHONPATH=build/host python3 host/frame_decoder_bench.py [--mb 4]
+
+Part of the lightTrackingRobot project.
+
+@author Wesley Campbell
+@date   2026-10-18
+@version 1.0.0
+"""
+
+import argparse
+import contextlib
+import io
+import os
+import random
+import struct
+import sys
+import time
+
+from unittest import mock
+
+import numpy as np
+
+# serialComs.py pulls in the serial port and the plotting at import, neither of which is used here
+for module in ("serial", "matplotlib", "matplotlib.pyplot", "matplotlib.ticker"):
+    sys.modules[module] = mock.MagicMock()
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"))
+import serialComs
+
+import framedecoder
+
+STRAY_BYTE_CHANCE = 0.002
+PIN_FRAME_CHANCE = 0.25
+OTHER_FRAME_CHANCE = 0.02
+MIN_BENCH_S = 1.0
+
+###################################################################3
+
+#                        CAPTURE
+
+###################################################################3
+
+def build_capture(size, rng):
+    data = bytearray()
+    headers = set(serialComs.HEADERS.keys())
+
+    while len(data) < size:
+        if rng.random() < STRAY_BYTE_CHANCE:
+            stray = rng.randrange(256)
+            while stray in headers:
+                stray = rng.randrange(256)
+            data.append(stray)
+
+        data += bytes([serialComs.DATA_PACKET_HEADER, rng.randrange(16), rng.randrange(2), rng.randrange(2)])
+        data += bytes([serialComs.ACTION_PACKET_HEADER, rng.randrange(2),
+                       rng.choice((0x00, 0x01, 0x10, 0x11)), rng.choice((0x00, 0x01, 0x10))])
+
+        if rng.random() < PIN_FRAME_CHANCE:
+            data += bytes([serialComs.PIN_DATA_PACKET_HEADER, rng.randrange(14, 22)])
+            data += struct.pack('<f', rng.uniform(0, 5))
+
+        if rng.random() < OTHER_FRAME_CHANCE:
+            header = rng.choice((serialComs.MEMORY_PACKET_HEADER, serialComs.BATTERY_PACKET_HEADER,
+                                 serialComs.PIN_SUMMARY_PACKET_HEADER))
+            data += bytes([header]) + bytes(rng.randrange(256) for _ in range(serialComs.HEADERS[header]))
+
+    return bytes(data)
+
+###################################################################3
+
+#                        DECODERS
+
+###################################################################3
+
+class CapturePort:
+    """
+    @brief Stands in for the serial port, ending the read with EOFError
+    """
+    def __init__(self, data):
+        self.stream = io.BytesIO(data)
+
+    def read(self, size):
+        chunk = self.stream.read(size)
+        if not chunk:
+            raise EOFError
+        return chunk
+
+def decode_read_packet(data):
+    port = CapturePort(data)
+    sensor, action, pin = [], [], []
+
+    # read_packet() prints every header it finds
+    with contextlib.redirect_stdout(io.StringIO()):
+        try:
+            while True:
+                packet = serialComs.read_packet(port)
+                if packet is None:
+                    break
+
+                header, payload = packet
+                if header == serialComs.DATA_PACKET_HEADER:
+                    light = serialComs.unpack_light_data(payload[0])
+                    sensor.append((sum(bit << n for n, bit in enumerate(light)), payload[1], payload[2]))
+                elif header == serialComs.ACTION_PACKET_HEADER:
+                    action.append((payload[0], serialComs.parseDriveData(payload[1]),
+                                   serialComs.parseServoData(payload[2])))
+                elif header == serialComs.PIN_DATA_PACKET_HEADER:
+                    pin.append((payload[0], serialComs.parsePinVoltageData(payload[1:5])[0]))
+        except EOFError:
+            pass
+
+    return sensor, action, pin
+
+def frame_count(columns):
+    return (len(columns["sensor"]["offset"]) + len(columns["action"]["offset"])
+            + len(columns["pin"]["offset"]) + columns["other_frames"])
+
+def time_decoder(decode, data):
+    """
+    @return (seconds per decode, last result), repeating for at least MIN_BENCH_S
+    """
+    runs = 0
+    start = time.perf_counter()
+    while True:
+        result = decode(data)
+        runs += 1
+        elapsed = time.perf_counter() - start
+        if elapsed >= MIN_BENCH_S:
+            return elapsed / runs, result
+
+###################################################################3
+
+#                        CHECKS
+
+###################################################################3
+
+def check_columns(native, python):
+    for table in ("sensor", "action", "pin"):
+        for field, column in python[table].items():
+            expected = np.asarray(column, dtype=native[table][field].dtype)
+            if not np.array_equal(native[table][field], expected):
+                return f"{table}.{field} differs"
+
+    for count in ("consumed", "other_frames", "skipped_bytes"):
+        if native[count] != python[count]:
+            return f"{count} {native[count]} against {python[count]}"
+    return None
+
+def check_read_packet(native, decoded):
+    sensor, action, pin = decoded
+    if len(sensor) != len(native["sensor"]["offset"]) or len(action) != len(native["action"]["offset"]) \
+            or len(pin) != len(native["pin"]["offset"]):
+        return "frame counts differ"
+
+    if [row[0] for row in sensor] != native["sensor"]["light"].tolist():
+        return "sensor.light differs"
+    if [row[0] for row in pin] != native["pin"]["pin"].tolist():
+        return "pin.pin differs"
+    if not np.array_equal(np.asarray([row[1] for row in pin], dtype=np.float32), native["pin"]["voltage"]):
+        return "pin.voltage differs"
+    return None
+
+def check_chunked(data, native, chunk):
+    """
+    @brief Feeds the capture in chunks, carrying the cut off tail over, which has to match one call
+    """
+    offsets = []
+    pending = b""
+    position = 0
+
+    for start in range(0, len(data), chunk):
+        buffer = pending + data[start:start + chunk]
+        result = framedecoder.decode(buffer, position)
+        offsets.append(result["sensor"]["offset"])
+        pending = buffer[result["consumed"]:]
+        position += result["consumed"]
+
+    if not np.array_equal(np.concatenate(offsets), native["sensor"]["offset"]):
+        return f"decoding in {chunk} byte chunks differs"
+    return None
+
+###################################################################3
+
+#                        MAIN
+
+###################################################################3
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("--mb", type=float, default=4, help="size of the synthetic capture")
+    args = parser.parse_args()
+
+    data = build_capture(int(args.mb * 1e6), random.Random(240))
+
+    native_s, native = time_decoder(framedecoder.decode, data)
+    python_s, python = time_decoder(serialComs.decode_frames_python, data)
+    read_packet_s, decoded = time_decoder(decode_read_packet, data)
+
+    for error in (check_columns(native, python), check_read_packet(native, decoded),
+                  check_chunked(data, native, 4093)):
+        if error:
+            print(f"frame_decoder_bench: {error}")
+            return 1
+
+    frames = frame_count(native)
+    print(f"capture {len(data) / 1e6:.1f} MB, {frames} frames, {native['skipped_bytes']} stray bytes")
+    print(f"{'decoder':<22} {'MB/s':>10} {'frames/s':>12} {'speedup':>9}")
+    for name, seconds in (("read_packet", read_packet_s), ("decode_frames_python", python_s),
+                          ("framedecoder", native_s)):
+        print(f"{name:<22} {len(data) / seconds / 1e6:>10.2f} {frames / seconds:>12.0f} "
+              f"{read_packet_s / seconds:>8.1f}x")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,153 @@
+/**
+ * @file framedecoder_module.cpp
+ *
+ * @brief CPython wrapper round frame_decoder.h, imported as `framedecoder`.
+ *
+ *     framedecoder.decode(data, offset=0) -> dict
+ *
+ * data is anything with the buffer protocol (bytes, bytearray, memoryview, mmap), offset is the
+ * stream position of its first byte. The result holds a dict of numpy columns for each frame type,
+ *
+ *     "sensor"  offset uint64, light uint8, collision uint8, capacitive uint8
+ *     "action"  offset uint64, collision uint8, drive uint8, servo uint8
+ *     "pin"     offset uint64, pin uint8, voltage float32
+ *
+ * and "consumed", "other_frames" and "skipped_bytes". Anything past "consumed" is a cut off frame
+ * to pass back in front of the next chunk. The decode runs without the GIL, and raises
+ * MemoryError if the columns can't grow.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+#include <string.h>
+#include <new>
+
+#include "frame_decoder.h"
+
+// Copies a column into a new numpy array and adds it to dict under name
+template <typename T>
+static bool addColumn(PyObject* dict, const char* name, const std::vector<T>& column, int type) {
+	npy_intp size = (npy_intp) column.size();
+	PyObject* array = PyArray_SimpleNew(1, &size, type);
+	if (!array)
+		return false;
+
+	if (size)
+		memcpy(PyArray_DATA((PyArrayObject*) array), column.data(), size * sizeof(T));
+
+	int status = PyDict_SetItemString(dict, name, array);
+	Py_DECREF(array);
+	return status == 0;
+}
+
+// Adds an empty dict under name, returning it borrowed
+static PyObject* addTable(PyObject* dict, const char* name) {
+	PyObject* table = PyDict_New();
+	if (!table)
+		return NULL;
+
+	int status = PyDict_SetItemString(dict, name, table);
+	Py_DECREF(table);
+	return (status == 0) ? table : NULL;
+}
+
+static bool addCount(PyObject* dict, const char* name, unsigned long long count) {
+	PyObject* value = PyLong_FromUnsignedLongLong(count);
+	if (!value)
+		return false;
+
+	int status = PyDict_SetItemString(dict, name, value);
+	Py_DECREF(value);
+	return status == 0;
+}
+
+static PyObject* buildResult(const frameColumnsStruct& columns, size_t consumed) {
+	PyObject* result = PyDict_New();
+	if (!result)
+		return NULL;
+
+	PyObject* sensor = addTable(result, "sensor");
+	PyObject* action = addTable(result, "action");
+	PyObject* pin = addTable(result, "pin");
+
+	bool ok = sensor && action && pin
+			&& addColumn(sensor, "offset", columns.sensor.offset, NPY_UINT64)
+			&& addColumn(sensor, "light", columns.sensor.light, NPY_UINT8)
+			&& addColumn(sensor, "collision", columns.sensor.collision, NPY_UINT8)
+			&& addColumn(sensor, "capacitive", columns.sensor.capacitive, NPY_UINT8)
+			&& addColumn(action, "offset", columns.action.offset, NPY_UINT64)
+			&& addColumn(action, "collision", columns.action.collision, NPY_UINT8)
+			&& addColumn(action, "drive", columns.action.drive, NPY_UINT8)
+			&& addColumn(action, "servo", columns.action.servo, NPY_UINT8)
+			&& addColumn(pin, "offset", columns.pin.offset, NPY_UINT64)
+			&& addColumn(pin, "pin", columns.pin.pin, NPY_UINT8)
+			&& addColumn(pin, "voltage", columns.pin.voltage, NPY_FLOAT32)
+			&& addCount(result, "consumed", consumed)
+			&& addCount(result, "other_frames", columns.otherFrames)
+			&& addCount(result, "skipped_bytes", columns.skippedBytes);
+
+	if (!ok) {
+		Py_DECREF(result);
+		return NULL;
+	}
+	return result;
+}
+
+static PyObject* decode(PyObject* /* module */, PyObject* args, PyObject* kwargs) {
+	static const char* keywords[] = {"data", "offset", NULL};
+	Py_buffer buffer;
+	unsigned long long offset = 0;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|K", (char**) keywords, &buffer, &offset))
+		return NULL;
+
+	frameColumnsStruct columns = {};
+	size_t consumed = 0;
+	bool outOfMemory = false;
+
+	// The columns grow without the GIL, so a failed allocation can't raise until it's back
+	Py_BEGIN_ALLOW_THREADS
+	try {
+		consumed = decodeFrames((const uint8_t*) buffer.buf, buffer.len, &columns, offset);
+	} catch (const std::bad_alloc&) {
+		outOfMemory = true;
+	}
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(&buffer);
+	if (outOfMemory)
+		return PyErr_NoMemory();
+	return buildResult(columns, consumed);
+}
+
+static PyMethodDef frameDecoderMethods[] = {
+	{"decode", (PyCFunction) (void (*)(void)) decode, METH_VARARGS | METH_KEYWORDS,
+		"decode(data, offset=0) -> dict of numpy columns for the sensor, action and pin frames"},
+	{NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef frameDecoderModule = {
+	PyModuleDef_HEAD_INIT,
+	"framedecoder",
+	"Decodes lightTrackingRobot telemetry captures into numpy columns",
+	-1,
+	frameDecoderMethods,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+};
+
+PyMODINIT_FUNC PyInit_framedecoder(void) {
+	import_array();
+	return PyModule_Create(&frameDecoderModule);
+}
@@ -0,0 +1,169 @@
+/**
+ * @file idle_bench.cpp
+ *
+ * @brief Duty cycle model of the idle power mode and the battery life it buys.
+ *
+ * Each scenario runs the firmware for SCENARIO_S simulated seconds and measures how much of
+ * the time the CPU spent asleep in sleep_cpu() and how many sonar pings it sent. Those feed
+ * a current model of the electronics (the Nano, the sonar; not the motors or servo) built
+ * from typical figures:
+ *
+ *     board      BOARD_MA always: power LED, USB serial chip, regulator
+ *     ATmega328P MCU_ACTIVE_MA awake, MCU_IDLE_MA in idle sleep (16 MHz, 5 V)
+ *     HC-SR04    SONAR_IDLE_MA, SONAR_PING_MA for the length of each ping
+ *
+ * The battery life is the usable charge, down to BATTERY_DEAD_VOLTS on the generated discharge
+ * curve, over the average current.
+ *
+ * The light latency is the time from the light appearing in front of the parked robot until
+ * a motor starts, over LATENCY_TRIALS random phases.
+ *
+ * Built twice by `make idle`: once as is, and once with POWER_NO_IDLE defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "includes.h"
+
+#define SCENARIO_S 60
+#define LATENCY_TRIALS 500
+#define ADC_DARK 100
+#define ADC_BRIGHT 700
+
+#define BOARD_MA 8.0
+#define MCU_ACTIVE_MA 9.0
+#define MCU_IDLE_MA 3.0
+#define SONAR_IDLE_MA 2.0
+#define SONAR_PING_MA 15.0
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+enum scenarioType {SCENARIO_PARKED, SCENARIO_STOPPED, SCENARIO_TRACKING, NUM_SCENARIOS};
+
+static const char* scenarioNames[NUM_SCENARIOS] = {"parked", "stopped", "tracking"};
+
+static void setPhotodiodes(uint16_t counts) {
+	sim.analog[PHOTODIODE_TOP_LEFT] = counts;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = counts;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = counts;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = counts;
+}
+
+static void runLoop() {
+	RobotDetection();
+	RobotPlanning();
+	RobotAction();
+}
+
+static void resetRobot(ROBOT_SPEED speed, uint16_t light) {
+	simReset();
+	sim.capTau = 50;
+	setPhotodiodes(light);
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = speed;
+	initPins();
+	initServo();
+}
+
+/*
+ * Average current of the electronics over one scenario (mA), and the CPU's awake fraction.
+ */
+static double runScenario(scenarioType type, double* awake, double* pingsPerS) {
+	switch (type) {
+		case SCENARIO_PARKED:
+			// Left in the dark long enough ago that the light search has given up
+			resetRobot(SLOW, ADC_DARK);
+			actionStates.Search = SEARCH_GAVE_UP;
+			break;
+		case SCENARIO_STOPPED:
+			resetRobot(STOPPED, ADC_BRIGHT);
+			break;
+		default:
+			resetRobot(SLOW, ADC_BRIGHT);
+			break;
+	}
+
+	uint64_t startUs = sim.timeUs;
+	uint64_t startSleepUs = sim.sleepUs;
+	uint32_t startPings = sim.sonarPings;
+	while (sim.timeUs < startUs + SCENARIO_S * 1000000ULL)
+		runLoop();
+
+	double seconds = (sim.timeUs - startUs) / 1e6;
+	double sleepS = (sim.sleepUs - startSleepUs) / 1e6;
+	uint32_t pings = sim.sonarPings - startPings;
+	double pingS = pings * (SIM_SONAR_TRIGGER_US + SIM_SONAR_US_PER_CM * ULTRASONIC_MAX_DIST) / 1e6;
+
+	*awake = 1 - sleepS / seconds;
+	*pingsPerS = pings / seconds;
+
+	double mcu = MCU_ACTIVE_MA * *awake + MCU_IDLE_MA * (1 - *awake);
+	double sonar = SONAR_IDLE_MA + (SONAR_PING_MA - SONAR_IDLE_MA) * pingS / seconds;
+	return BOARD_MA + mcu + sonar;
+}
+
+static uint64_t lightUs;
+static uint64_t motorUs;
+
+static void lightOn() {
+	setPhotodiodes(ADC_BRIGHT);
+	lightUs = sim.eventAtUs;
+}
+
+static void onOutput(uint8_t kind, uint8_t pin, int value, uint64_t timeUs) {
+	if (kind == SIM_OUTPUT_PWM && (pin == MOTOR_LEFT || pin == MOTOR_RIGHT) && value > 0 && motorUs == 0)
+		motorUs = timeUs;
+}
+
+int main() {
+#ifdef POWER_NO_IDLE
+	printf("Idle mode: off\n");
+#else
+	printf("Idle mode: light every %d ms, touch every %d ms\n", IDLE_LIGHT_INTERVAL, IDLE_CAP_INTERVAL);
+#endif
+
+	double usable = BATTERY_CAPACITY_MAH - batteryChargeLeft(BATTERY_DEAD_VOLTS);
+
+	printf("%-9s %9s %9s %9s %12s\n", "scenario", "awake %", "pings/s", "mA", "battery h");
+	for (int type = 0; type < NUM_SCENARIOS; type++) {
+		double awake, pingsPerS;
+		double mA = runScenario((scenarioType) type, &awake, &pingsPerS);
+		printf("%-9s %9.1f %9.1f %9.1f %12.1f\n", scenarioNames[type], awake * 100, pingsPerS, mA, usable / mA);
+	}
+
+	std::mt19937 rng(240);
+	std::uniform_int_distribution<uint32_t> phase(0, 100000);
+	std::vector<double> latencies;
+
+	for (int trial = 0; trial < LATENCY_TRIALS; trial++) {
+		resetRobot(SLOW, ADC_DARK);
+		sim.onOutput = onOutput;
+		motorUs = 0;
+
+		while (sim.timeUs < 500000)
+			runLoop();
+		simSchedule(sim.timeUs + phase(rng), lightOn);
+		while (motorUs == 0)
+			runLoop();
+
+		latencies.push_back((motorUs - lightUs) / 1000.0);
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	printf("Light to motor from parked: p50 %.1f ms, p99 %.1f ms\n",
+			latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]);
+	return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file io_bench.cpp
+ *
+ * @brief Arduino pin calls made by the action phase, with direct port I/O and without.
+ *
+ * Drives the robot for RUN_S simulated seconds with the light moving between left, ahead and
+ * right every LIGHT_PERIOD_US, and an obstacle showing up inside COLLISION_DISTANCE every
+ * OBSTACLE_PERIOD_US, so the LEDs and both motors are written over and over. It reports how many
+ * Arduino pin calls initPins() and each RobotAction() make. Direct port I/O makes none by
+ * construction, so the count only shows which writes still go through the Arduino core, not how
+ * fast either way is. The shims don't model the cost of a register access.
+ *
+ * Built twice by `make io`: once as is, and once with BOARD_ARDUINO_IO defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+
+#define RUN_S 20
+#define LIGHT_PERIOD_US 250000
+#define OBSTACLE_PERIOD_US 2000000
+#define OBSTACLE_US 300000
+#define ADC_DARK 100
+#define ADC_BRIGHT 700
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+static void placeWorld(uint64_t timeUs) {
+	// Left, ahead, right, ahead
+	int step = (timeUs / LIGHT_PERIOD_US) % 4;
+	bool left = step != 2;
+	bool right = step != 0;
+
+	sim.analog[PHOTODIODE_TOP_LEFT] = left ? ADC_BRIGHT : ADC_DARK;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = left ? ADC_BRIGHT : ADC_DARK;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = right ? ADC_BRIGHT : ADC_DARK;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = right ? ADC_BRIGHT : ADC_DARK;
+
+	sim.sonarCm = (timeUs % OBSTACLE_PERIOD_US < OBSTACLE_US) ? COLLISION_DISTANCE - 2 : 0;
+}
+
+int main() {
+#ifdef BOARD_ARDUINO_IO
+	printf("Pin I/O: Arduino calls\n");
+#else
+	printf("Pin I/O: direct port access\n");
+#endif
+
+	simReset();
+	sim.capTau = 50;
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = MEDIUM;
+
+	uint32_t setupCalls = sim.pinCalls;
+	initPins();
+	setupCalls = sim.pinCalls - setupCalls;
+	initServo();
+
+	uint32_t loops = 0;
+	uint32_t actionCalls = 0;
+
+	uint64_t startUs = sim.timeUs;
+	while (sim.timeUs < startUs + RUN_S * 1000000ULL) {
+		placeWorld(sim.timeUs - startUs);
+
+		RobotDetection();
+		RobotPlanning();
+
+		uint32_t calls = sim.pinCalls;
+		RobotAction();
+
+		actionCalls += sim.pinCalls - calls;
+		loops++;
+	}
+
+	printf("initPins() pin calls: %u\n", setupCalls);
+	printf("%-8s %12s  (Arduino calls per RobotAction(), not a time)\n", "loops", "pin calls");
+	printf("%-8u %12.2f\n", loops, (double) actionCalls / loops);
+	return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * @file latency_bench.cpp
+ *
+ * @brief Measures stimulus-to-actuation latency of the control loop on the host build.
+ *
+ * For every trial the virtual hardware is put in a resting state, then a step stimulus is
+ * injected at a random point in time, and therefore at a random phase of loop(). The latency
+ * is the time from the step until the first motor PWM or servo output that responds to it.
+ * The simulated clock follows the modelled cost of every ADC read, sonar ping, capacitive
+ * sample and serial byte, so the 40 ms sonar gate and the loop period show up as they would
+ * on the Nano.
+ *
+ * Stimuli:
+ *     light      - a photodiode pair on one side goes bright, waits for a motor to start
+ *     elevation  - the top or bottom photodiode pair goes bright, waits for the servo to move
+ *     obstacle   - an obstacle appears inside COLLISION_DISTANCE while driving, waits for a motor to stop
+ *     bumper     - the bumper closes while driving, waits for a motor to stop
+ *
+ * The shim runs an interrupt handler in the same simulated instant as the edge that triggers it,
+ * so the bumper's latency, the INT0 response and a few register stores, is below what it can
+ * resolve. Its trials still count misses, a bump that doesn't stop the motors, but its latency
+ * is reported as not measured rather than as 0.
+ *
+ *     latency_bench [--trials N] [--seed S] [--history file.csv --label build]
+ *
+ * With --history, one row per stimulus is appended to the given CSV so results can be
+ * compared across builds.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "includes.h"
+
+#define ADC_DARK 100
+#define ADC_BRIGHT 700
+#define CAP_TAU_IDLE 50
+
+// Time spent in the resting state before each step (us)
+#define SETTLE_US 150000
+// In the dark that has to outlast the tracker coasting on the last light (us)
+#define DARK_SETTLE_US (TRACKER_COAST_MS * 1000UL + SETTLE_US)
+// And after a bump, outlast the latch held after the switch opens (us)
+#define BUMPER_SETTLE_US (BUMPER_HOLD_MS * 1000UL + SETTLE_US)
+// Window over which the step is placed, wide enough to cover a full sonar gate (us)
+#define PHASE_SPAN_US 50000
+// A trial without a response after this long counts as a miss (us)
+#define RESPONSE_TIMEOUT_US 1000000
+
+#define DEFAULT_TRIALS 2000
+
+enum stimulusType {STIMULUS_LIGHT, STIMULUS_ELEVATION, STIMULUS_OBSTACLE, STIMULUS_BUMPER, NUM_STIMULI};
+
+static const char* stimulusNames[NUM_STIMULI] = {"light", "elevation", "obstacle", "bumper"};
+// Whether the simulated clock can time the response, see above
+static const bool stimulusTimed[NUM_STIMULI] = {true, true, true, false};
+
+/*
+ * @brief State of the trial in progress
+ */
+static struct {
+	stimulusType type;
+	int index;
+	bool stepped;
+	uint64_t stepUs;
+	uint64_t responseUs;
+} trial;
+
+static void setPhotodiodes(uint16_t topLeft, uint16_t bottomLeft, uint16_t bottomRight, uint16_t topRight) {
+	sim.analog[PHOTODIODE_TOP_LEFT] = topLeft;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = bottomLeft;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = bottomRight;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = topRight;
+}
+
+/*
+ * Puts the hardware in the resting state for the trial and returns how long it needs to settle (us).
+ */
+static uint32_t applyBaseline() {
+	sim.capTau = CAP_TAU_IDLE;
+	sim.sonarCm = 0;
+	simSetInput(BUMPER_PIN, HIGH);
+
+	switch (trial.type) {
+		case STIMULUS_LIGHT:
+		case STIMULUS_ELEVATION:
+			setPhotodiodes(ADC_DARK, ADC_DARK, ADC_DARK, ADC_DARK);
+			return DARK_SETTLE_US;
+		case STIMULUS_OBSTACLE:
+		case STIMULUS_BUMPER:
+			// Light dead ahead, so the robot is driving straight
+			setPhotodiodes(ADC_BRIGHT, ADC_BRIGHT, ADC_BRIGHT, ADC_BRIGHT);
+			return (trial.type == STIMULUS_BUMPER) ? BUMPER_SETTLE_US : SETTLE_US;
+		default:
+			return SETTLE_US;
+	}
+}
+
+static void applyStep() {
+	// Alternate sides so the servo never gets pinned against a limit
+	bool firstSide = (trial.index % 2) == 0;
+
+	switch (trial.type) {
+		case STIMULUS_LIGHT:
+			if (firstSide)
+				setPhotodiodes(ADC_BRIGHT, ADC_BRIGHT, ADC_DARK, ADC_DARK);
+			else
+				setPhotodiodes(ADC_DARK, ADC_DARK, ADC_BRIGHT, ADC_BRIGHT);
+			break;
+		case STIMULUS_ELEVATION:
+			if (firstSide)
+				setPhotodiodes(ADC_BRIGHT, ADC_DARK, ADC_DARK, ADC_BRIGHT);
+			else
+				setPhotodiodes(ADC_DARK, ADC_BRIGHT, ADC_BRIGHT, ADC_DARK);
+			break;
+		case STIMULUS_OBSTACLE:
+			sim.sonarCm = COLLISION_DISTANCE - 2;
+			break;
+		case STIMULUS_BUMPER:
+			trial.stepped = true;
+			trial.stepUs = sim.eventAtUs;
+			simSetInput(BUMPER_PIN, LOW);
+			return;
+		default:
+			break;
+	}
+
+	trial.stepped = true;
+	trial.stepUs = sim.eventAtUs;
+}
+
+static bool isResponse(uint8_t kind, uint8_t pin, int value) {
+	bool motorPin = (kind == SIM_OUTPUT_PWM) && (pin == MOTOR_LEFT || pin == MOTOR_RIGHT);
+
+	switch (trial.type) {
+		case STIMULUS_LIGHT:
+			return motorPin && value != 0;
+		case STIMULUS_ELEVATION:
+			return kind == SIM_OUTPUT_SERVO;
+		case STIMULUS_OBSTACLE:
+		case STIMULUS_BUMPER:
+			return motorPin && value == 0;
+		default:
+			return false;
+	}
+}
+
+static void onOutput(uint8_t kind, uint8_t pin, int value, uint64_t timeUs) {
+	if (trial.stepped && trial.responseUs == 0 && isResponse(kind, pin, value))
+		trial.responseUs = timeUs;
+}
+
+static void runLoop() {
+	RobotDetection();
+	RobotPlanning();
+	RobotAction();
+}
+
+/*
+ * Runs one trial and returns its latency in us, or -1 if nothing responded in time.
+ */
+static long runTrial(std::mt19937& rng) {
+	std::uniform_int_distribution<uint32_t> phase(0, PHASE_SPAN_US);
+
+	trial.stepped = false;
+	trial.responseUs = 0;
+	uint64_t settled = sim.timeUs + applyBaseline();
+	while (sim.timeUs < settled)
+		runLoop();
+
+	simSchedule(sim.timeUs + phase(rng), applyStep);
+
+	uint64_t deadline = sim.eventAtUs + RESPONSE_TIMEOUT_US;
+	while (trial.responseUs == 0 && sim.timeUs < deadline)
+		runLoop();
+
+	sim.onEvent = NULL;
+	if (trial.responseUs == 0)
+		return -1;
+	return (long) (trial.responseUs - trial.stepUs);
+}
+
+static double percentile(const std::vector<long>& sorted, double p) {
+	if (sorted.empty())
+		return 0;
+	size_t index = (size_t) (p * (sorted.size() - 1) + 0.5);
+	return sorted[index] / 1000.0;
+}
+
+int main(int argc, char** argv) {
+	int trials = DEFAULT_TRIALS;
+	unsigned seed = 240;
+	const char* historyPath = NULL;
+	const char* label = "local";
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+			trials = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = (unsigned) strtoul(argv[++i], NULL, 10);
+		} else if (strcmp(argv[i], "--history") == 0 && i + 1 < argc) {
+			historyPath = argv[++i];
+		} else if (strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+			label = argv[++i];
+		} else {
+			fprintf(stderr, "usage: latency_bench [--trials N] [--seed S] [--history file.csv --label build]\n");
+			return 2;
+		}
+	}
+
+	std::mt19937 rng(seed);
+
+	simReset();
+	sim.onOutput = onOutput;
+	initPins();
+	initServo();
+
+	FILE* history = NULL;
+	if (historyPath) {
+		history = fopen(historyPath, "a+");
+		if (!history) {
+			fprintf(stderr, "latency_bench: cannot open %s\n", historyPath);
+			return 2;
+		}
+		fseek(history, 0, SEEK_END);
+		if (ftell(history) == 0)
+			fprintf(history, "build,stimulus,trials,p50_ms,p99_ms,max_ms,misses\n");
+	}
+
+	printf("%-10s %8s %9s %9s %9s %7s\n", "stimulus", "trials", "p50 ms", "p99 ms", "max ms", "misses");
+
+	for (int type = 0; type < NUM_STIMULI; type++) {
+		std::vector<long> latencies;
+		int misses = 0;
+
+		trial.type = (stimulusType) type;
+		for (trial.index = 0; trial.index < trials; trial.index++) {
+			long latency = runTrial(rng);
+			if (latency < 0)
+				misses++;
+			else
+				latencies.push_back(latency);
+		}
+
+		std::sort(latencies.begin(), latencies.end());
+		double p50 = percentile(latencies, 0.50);
+		double p99 = percentile(latencies, 0.99);
+		double max = percentile(latencies, 1.0);
+
+		if (!stimulusTimed[type]) {
+			printf("%-10s %8d %9s %9s %9s %7d\n", stimulusNames[type], trials, "-", "-", "-", misses);
+			if (history)
+				fprintf(history, "%s,%s,%d,,,,%d\n", label, stimulusNames[type], trials, misses);
+			continue;
+		}
+
+		printf("%-10s %8d %9.2f %9.2f %9.2f %7d\n", stimulusNames[type], trials, p50, p99, max, misses);
+		if (history)
+			fprintf(history, "%s,%s,%d,%.2f,%.2f,%.2f,%d\n", label, stimulusNames[type], trials, p50, p99, max, misses);
+	}
+
+	if (history)
+		fclose(history);
+	return 0;
+}
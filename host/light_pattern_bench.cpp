@@ -0,0 +1,148 @@
+/**
+ * @file light_pattern_bench.cpp
+ *
+ * @brief Checks that every pattern of lit photodiodes moves the wheels and servo the way
+ * lightPatternBearings says, through whatever path drives them in this build.
+ *
+ * Each of the 15 patterns with light in it is held on the photodiodes, LIT_V on the lit ones and
+ * DARK_V on the rest, for RUN_MS while the robot drives at BENCH_SPEED. Then the motor targets
+ * give the turn, and how far the servo moved gives the tilt. The table's flags are expected as:
+ *
+ *     LEFT or RIGHT alone   a turn that way
+ *     both or neither       no turn, straight on or stopped
+ *     UP or DOWN alone      a tilt that way of more than TILT_DEG
+ *     both or neither       the servo holds within TILT_DEG
+ *
+ * Run at a fast loop and at a slow one, past TRACKER_SERVO_MAX_LOOP_MS, where the servo goes back
+ * to the light flags. With the tracker the wheels follow the photodiode balance rather than the
+ * flags, so it checks the two agree.
+ *
+ * Built twice by `make light-patterns`: once as is, and once with LIGHT_NO_TRACKER defined.
+ * Exits non-zero if any pattern moves the robot the wrong way.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+
+#define LIT_V 4.0
+#define DARK_V 0.3
+#define RUN_MS 300
+#define TILT_DEG 1.0
+#define BENCH_SPEED MEDIUM
+
+#define CAP_TAU_FAST 50
+#define CAP_TAU_SLOW 40000
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+enum TURN {TURN_NONE, TURN_LEFT, TURN_RIGHT};
+enum TILT {TILT_HOLD, TILT_UP, TILT_DOWN};
+
+static const char* turnNames[] = {"none", "left", "right"};
+static const char* tiltNames[] = {"hold", "up", "down"};
+
+static const uint8_t photodiodePins[NUM_PHOTODIODES] = {PHOTODIODE_TOP_LEFT, PHOTODIODE_BOTTOM_LEFT,
+		PHOTODIODE_BOTTOM_RIGHT, PHOTODIODE_TOP_RIGHT};
+static const char* photodiodeNames[NUM_PHOTODIODES] = {"TL", "BL", "BR", "TR"};
+
+static TURN expectedTurn(LIGHT_DIR dir) {
+	bool left = dir & LIGHT_LEFT;
+	bool right = dir & LIGHT_RIGHT;
+	return (left == right) ? TURN_NONE : left ? TURN_LEFT : TURN_RIGHT;
+}
+
+static TILT expectedTilt(LIGHT_DIR dir) {
+	bool up = dir & LIGHT_UP;
+	bool down = dir & LIGHT_DOWN;
+	return (up == down) ? TILT_HOLD : up ? TILT_UP : TILT_DOWN;
+}
+
+static uint16_t voltsToCounts(double volts) {
+	return (uint16_t) (volts / VOLTAGE_MAX * SENSOR_MAX_OUT);
+}
+
+/*
+ * Holds one pattern on the photodiodes for RUN_MS and reads back the turn and tilt.
+ */
+static void runPattern(uint8_t mask, long capTau, TURN* turn, TILT* tilt) {
+	simReset();
+	sim.capTau = capTau;
+	for (int i = 0; i < NUM_PHOTODIODES; i++)
+		sim.analog[photodiodePins[i]] = voltsToCounts((mask & (1 << i)) ? LIT_V : DARK_V);
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = BENCH_SPEED;
+	initPins();
+	initServo();
+	float startAngle = servoPlan.position;
+
+	uint64_t endUs = sim.timeUs + RUN_MS * 1000ULL;
+	while (sim.timeUs < endUs) {
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+	}
+
+	uint8_t left = motors[MOTOR_ID_LEFT].target;
+	uint8_t right = motors[MOTOR_ID_RIGHT].target;
+	*turn = (left == right) ? TURN_NONE : (left < right) ? TURN_LEFT : TURN_RIGHT;
+
+	float moved = servoPlan.position - startAngle;
+	*tilt = (moved > TILT_DEG) ? TILT_UP : (moved < -TILT_DEG) ? TILT_DOWN : TILT_HOLD;
+}
+
+int main() {
+	int wrong = 0;
+
+#ifdef LIGHT_NO_TRACKER
+	printf("Light patterns: light flags only\n");
+#else
+	printf("Light patterns: light tracker, servo on the flags past %d ms loops\n", TRACKER_SERVO_MAX_LOOP_MS);
+#endif
+	printf("%-12s %-11s %-11s %-11s %s\n", "lit", "table", "fast", "slow", "");
+
+	for (uint8_t mask = 1; mask < NUM_LIGHT_PATTERNS; mask++) {
+		char lit[16] = "";
+		for (int i = 0; i < NUM_PHOTODIODES; i++) {
+			if (mask & (1 << i)) {
+				strcat(lit, photodiodeNames[i]);
+				strcat(lit, " ");
+			}
+		}
+
+		LIGHT_DIR dir = lightPatternDirection(mask);
+		TURN wantTurn = expectedTurn(dir);
+		TILT wantTilt = expectedTilt(dir);
+		printf("%-12s %-5s %-5s", lit, turnNames[wantTurn], tiltNames[wantTilt]);
+
+		bool ok = true;
+		long capTaus[] = {CAP_TAU_FAST, CAP_TAU_SLOW};
+		for (long capTau : capTaus) {
+			TURN turn;
+			TILT tilt;
+			runPattern(mask, capTau, &turn, &tilt);
+			ok = ok && turn == wantTurn && tilt == wantTilt;
+			printf(" %-5s %-5s", turnNames[turn], tiltNames[tilt]);
+		}
+
+		printf(" %s\n", ok ? "ok" : "WRONG");
+		if (!ok)
+			wrong++;
+	}
+
+	if (wrong) {
+		printf("light_pattern_bench: %d pattern(s) moved the robot the wrong way\n", wrong);
+		return 1;
+	}
+	return 0;
+}
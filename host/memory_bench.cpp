@@ -0,0 +1,94 @@
+/**
+ * @file memory_bench.cpp
+ *
+ * @brief Checks the SRAM monitor against the heap the telemetry frames churn through.
+ *
+ * Runs the telemetry profile for RUN_S simulated seconds. Every frame the firmware sends is
+ * malloc()ed as a dataBlob and freed again, which on the host takes it from the shim's model of
+ * the AVR heap and leaves its bytes above __brkval. Reports how many of those cycles ran, the
+ * heap peak, and the smallest margin the monitor saw.
+ *
+ * Then it digs the stack down to within DIG_MARGIN bytes of the heap peak and checks the monitor
+ * does see that.
+ *
+ * Exits non-zero if the malloc()/free() cycles alone trip MEMORY_LOW, or the deep stack doesn't.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+
+#define RUN_S 30
+#define DIG_MARGIN (MEMORY_MARGIN_THRESHOLD / 2)
+#define CAP_UNTOUCHED 50
+#define ADC_STEADY 600
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+static void runFor(uint32_t ms) {
+	uint64_t endUs = sim.timeUs + ms * 1000ULL;
+
+	while (sim.timeUs < endUs) {
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+	}
+}
+
+int main() {
+	simReset();
+	sim.capTau = CAP_UNTOUCHED;
+	sim.analog[PHOTODIODE_TOP_LEFT] = ADC_STEADY;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = ADC_STEADY;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = ADC_STEADY;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = ADC_STEADY;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = ROBOT_START_SPEED;
+	initPins();
+	initSerialComm();
+	initServo();
+
+	runFor(RUN_S * 1000);
+	bool churnOk = memoryStats.status == MEMORY_OK && sim.mallocs > 0 && sim.mallocFailures == 0;
+
+	uint16_t peak = SIM_HEAP_START;
+	for (uint16_t address = SP - 1; address >= SIM_HEAP_START; address--) {
+		if (*simRamAt(address) != MEMORY_CANARY) {
+			peak = address + 1;
+			break;
+		}
+	}
+	printf("Memory monitor: %lu blob malloc/free cycles in %d s, heap peak 0x%04x, __brkval 0x%04x\n",
+			(unsigned long) sim.mallocs, RUN_S, peak, sim.heapBreak);
+	printf("churn        min margin %5u B  %s\n", memoryStats.minMargin,
+			memoryStats.status == MEMORY_OK ? "ok" : "MEMORY_LOW");
+
+	// A call chain that went deep enough to come within DIG_MARGIN of the heap
+	for (uint16_t address = peak + DIG_MARGIN; address < SP; address++)
+		*simRamAt(address) = 0;
+	runFor(2 * MEMORY_CHECK_INTERVAL);
+	bool digOk = memoryStats.status == MEMORY_LOW;
+
+	printf("deep stack   min margin %5u B  %s\n", memoryStats.minMargin,
+			memoryStats.status == MEMORY_OK ? "ok" : "MEMORY_LOW");
+
+	if (!churnOk) {
+		printf("memory_bench: malloc()/free() alone tripped MEMORY_LOW\n");
+		return 1;
+	}
+	if (!digOk) {
+		printf("memory_bench: the deep stack wasn't seen\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file motor_bench.cpp
+ *
+ * @brief Measures the current drawn when the robot sets off, and how straight it drives.
+ *
+ * Launch: the robot sits still with the light dead ahead, then its speed is switched from
+ * STOPPED to SLOW, MEDIUM or FAST. The peak motor current, the lowest the battery sags to and
+ * the time to reach 90% of the final speed are reported.
+ *
+ * Straight line: the right wheel is made RIGHT_WHEEL_GAIN times stronger than the left, and
+ * the robot drives open loop at MOTOR_CAL_SPEED for STRAIGHT_MS with no trim, with the default
+ * RIGHT_MOTOR_BALANCE_FACTOR, and with the balance found by calibrateMotorTrim(). The heading
+ * change and sideways drift over the run are reported.
+ *
+ * Built twice by `make motors`: once as is, and once with MOTOR_NO_RAMP defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <vector>
+
+#include "includes.h"
+#include "world.h"
+
+#define RIGHT_WHEEL_GAIN 1.10
+#define IDLE_US 500000
+#define LAUNCH_US 1500000
+#define STRAIGHT_MS 3000
+#define LIGHT_RANGE_CM 800
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+/*
+ * @brief What happened while setting off
+ */
+struct launchResult {
+	double peakAmps;
+	double minVolts;
+	double riseMs;
+};
+
+static launchResult launch;
+
+static void launchTick(uint64_t fromUs, uint64_t toUs) {
+	worldTick(fromUs, toUs);
+
+	if (world.robot.motorAmps > launch.peakAmps)
+		launch.peakAmps = world.robot.motorAmps;
+	if (world.robot.supplyVolts < launch.minVolts)
+		launch.minVolts = world.robot.supplyVolts;
+}
+
+static void runLoop() {
+	RobotDetection();
+	RobotPlanning();
+	RobotAction();
+}
+
+static void resetRobot() {
+	simReset();
+	worldReset();
+	world.light = {LIGHT_RANGE_CM, 0, 0, 0, 0, true};
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = STOPPED;
+	initPins();
+	initServo();
+}
+
+static launchResult runLaunch(ROBOT_SPEED speed) {
+	resetRobot();
+	sim.onTick = launchTick;
+	world.drivePhotodiodes = false;
+	sim.analog[PHOTODIODE_TOP_LEFT] = 700;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = 700;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = 700;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = 700;
+	sim.capTau = 50;
+
+	while (sim.timeUs < IDLE_US)
+		runLoop();
+
+	launch = {0, world.robot.batteryVolts, 0};
+	robotSpeed = speed;
+	uint64_t startUs = sim.timeUs;
+
+	// Note when the speed first gets within 10% of where it ends up
+	double finalSpeed = 0;
+	uint64_t riseUs = 0;
+	std::vector<std::pair<uint64_t, double>> samples;
+	while (sim.timeUs < startUs + LAUNCH_US) {
+		runLoop();
+		samples.push_back({sim.timeUs - startUs, worldSpeed()});
+	}
+	finalSpeed = worldSpeed();
+	for (auto& sample : samples) {
+		if (sample.second >= 0.9 * finalSpeed) {
+			riseUs = sample.first;
+			break;
+		}
+	}
+
+	launch.riseMs = riseUs / 1000.0;
+	return launch;
+}
+
+/*
+ * Drives open loop with the given balance and returns the heading change (deg) and drift (cm).
+ */
+static void runStraight(int balance, double* headingDeg, double* driftCm) {
+	resetRobot();
+	world.robot.rightGain = RIGHT_WHEEL_GAIN;
+	setMotorBalance(balance);
+
+	unsigned long start = millis();
+	setMotorSpeed(MOTOR_ID_LEFT, MOTOR_CAL_SPEED);
+	setMotorSpeed(MOTOR_ID_RIGHT, MOTOR_CAL_SPEED);
+	while (millis() - start < STRAIGHT_MS) {
+		updateMotors();
+		delay(1);
+	}
+
+	*headingDeg = world.robot.heading * 180 / M_PI;
+	*driftCm = world.robot.y;
+}
+
+int main() {
+	const ROBOT_SPEED speeds[] = {SLOW, MEDIUM, FAST};
+	const char* speedNames[] = {"SLOW", "MEDIUM", "FAST"};
+
+#ifdef MOTOR_NO_RAMP
+	printf("Motor ramp: off\n");
+#else
+	printf("Motor ramp: %d ms from 0 to full PWM\n", MOTOR_RAMP_MS);
+#endif
+	printf("%-7s %10s %10s %10s\n", "launch", "peak A", "min V", "rise ms");
+	for (int s = 0; s < 3; s++) {
+		launchResult result = runLaunch(speeds[s]);
+		printf("%-7s %10.2f %10.2f %10.0f\n", speedNames[s], result.peakAmps, result.minVolts, result.riseMs);
+	}
+
+	// Calibrate against a light straight ahead with the uneven wheels
+	resetRobot();
+	world.robot.rightGain = RIGHT_WHEEL_GAIN;
+	uint64_t startUs = sim.timeUs;
+	int calibrated = calibrateMotorTrim();
+	double calibrationS = (sim.timeUs - startUs) / 1e6;
+
+	const char* trimNames[] = {"none", "default", "calibrated"};
+	const int balances[] = {0, RIGHT_MOTOR_BALANCE_FACTOR, calibrated};
+
+	printf("\nRight wheel %.0f%% stronger, calibration took %.1f s\n", (RIGHT_WHEEL_GAIN - 1) * 100, calibrationS);
+	printf("%-11s %8s %12s %10s\n", "trim", "balance", "heading deg", "drift cm");
+	for (int t = 0; t < 3; t++) {
+		double heading, drift;
+		runStraight(balances[t], &heading, &drift);
+		printf("%-11s %8d %12.1f %10.1f\n", trimNames[t], balances[t], heading, drift);
+	}
+
+	return 0;
+}
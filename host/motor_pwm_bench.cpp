@@ -0,0 +1,113 @@
+/**
+ * @file motor_pwm_bench.cpp
+ *
+ * @brief Measures the PWM waveform on both motor pins, and checks the other timers were left alone.
+ *
+ * After initPins() and initServo() both wheels are run up to each of SPEEDS through
+ * setMotorSpeed() and updateMotors(), and the waveform on MOTOR_LEFT and MOTOR_RIGHT is worked out
+ * from the timer registers (simPwmWaveform()). Reports each pin's frequency and duty, and the
+ * duty the trim asked for.
+ *
+ * Fails if the two wheels run at different frequencies, a duty is off from what was written, or
+ * Timer0 (millis()) or Timer1 (the servo) no longer have the settings the core gave them.
+ *
+ * Built twice by `make motor-pwm`: once as is, and once with MOTOR_PWM_FAST defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+
+#define SETTLE_MS (MOTOR_RAMP_MS + 100)
+#define DUTY_TOLERANCE 1e-9
+
+static const uint8_t SPEEDS[] = {MOTOR_RAMP_START, SLOW, MEDIUM, FAST};
+
+/*
+ * @brief Timer registers the motor PWM must not touch
+ */
+struct otherTimers {
+	uint8_t tccr0a, tccr0b, timsk0;
+	uint8_t tccr1a, tccr1b, timsk1;
+};
+
+static otherTimers readOtherTimers() {
+	return {TCCR0A, TCCR0B, TIMSK0, TCCR1A, TCCR1B, TIMSK1};
+}
+
+static bool sameTimers(const otherTimers& a, const otherTimers& b) {
+	return a.tccr0a == b.tccr0a && a.tccr0b == b.tccr0b && a.timsk0 == b.timsk0
+			&& a.tccr1a == b.tccr1a && a.tccr1b == b.tccr1b && a.timsk1 == b.timsk1;
+}
+
+// The duty the waveform generator should give for a written PWM
+static double expectedDuty(uint8_t pwm) {
+	if (pwm == 255)
+		return 1;
+#ifdef MOTOR_PWM_FAST
+	return (pwm + 1) / 256.0;
+#else
+	return pwm / 255.0;
+#endif
+}
+
+int main() {
+#ifdef MOTOR_PWM_FAST
+	printf("Motor PWM: Timer2 fast, prescaler %d, %lu Hz\n", MOTOR_PWM_PRESCALER, (unsigned long) MOTOR_PWM_HZ);
+#else
+	printf("Motor PWM: Timer2 phase correct, prescaler %d, %lu Hz\n", MOTOR_PWM_PRESCALER,
+			(unsigned long) MOTOR_PWM_HZ);
+#endif
+
+	simReset();
+	otherTimers coreTimers = readOtherTimers();
+	initPins();
+	initServo();
+
+	bool ok = true;
+	printf("%-6s %10s %9s %9s %10s %9s %9s\n", "speed", "left Hz", "duty %", "asked %",
+			"right Hz", "duty %", "asked %");
+
+	for (uint8_t speed : SPEEDS) {
+		setMotorSpeed(MOTOR_ID_LEFT, speed);
+		setMotorSpeed(MOTOR_ID_RIGHT, speed);
+		for (int ms = 0; ms < SETTLE_MS; ms++) {
+			updateMotors();
+			simAdvance(1000);
+		}
+		simSyncOutputs();
+
+		double hz[NUM_MOTORS], duty[NUM_MOTORS];
+		for (int i = 0; i < NUM_MOTORS; i++) {
+			if (!simPwmWaveform(motors[i].pin, &hz[i], &duty[i])) {
+				printf("motor_pwm_bench: pin %u isn't putting out PWM\n", motors[i].pin);
+				return 1;
+			}
+			if (fabs(duty[i] - expectedDuty(motors[i].written)) > DUTY_TOLERANCE)
+				ok = false;
+		}
+		if (hz[MOTOR_ID_LEFT] != hz[MOTOR_ID_RIGHT])
+			ok = false;
+
+		printf("%-6u %10.0f %9.1f %9.1f %10.0f %9.1f %9.1f\n", speed,
+				hz[MOTOR_ID_LEFT], 100 * duty[MOTOR_ID_LEFT], 100 * expectedDuty(motors[MOTOR_ID_LEFT].written),
+				hz[MOTOR_ID_RIGHT], 100 * duty[MOTOR_ID_RIGHT], 100 * expectedDuty(motors[MOTOR_ID_RIGHT].written));
+	}
+
+	if (!sameTimers(coreTimers, readOtherTimers())) {
+		printf("motor_pwm_bench: Timer0 or Timer1 settings changed\n");
+		return 1;
+	}
+	if (!ok) {
+		printf("motor_pwm_bench: the wheels' PWM doesn't match\n");
+		return 1;
+	}
+	printf("Timer0 and Timer1 untouched\n");
+	return 0;
+}
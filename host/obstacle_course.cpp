@@ -0,0 +1,170 @@
+/**
+ * @file obstacle_course.cpp
+ *
+ * @brief Drives the robot down a cluttered simulated course and reports speed and impacts.
+ *
+ * The light is dead ahead, so the robot drives straight for COURSE_CM. Obstacles are scattered
+ * along the course at random spacing, a third of them in the robot's path and the rest off to either side. Whenever the
+ * robot has been standing still in front of one for OBSTACLE_CLEAR_US it is taken away, like
+ * someone clearing the path, and the robot carries on. Each run is repeated at SLOW, MEDIUM
+ * and FAST, and the average speed over the course and the number of impacts are reported.
+ *
+ * Built twice by `make course`: once as is, using time-to-collision braking, and once with
+ * COLLISION_FIXED_STOP defined, for the plain COLLISION_DISTANCE stop.
+ *
+ *     obstacle_course [--runs N] [--seed S]
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <random>
+
+#include "includes.h"
+#include "world.h"
+
+#define COURSE_CM 2000
+#define OBSTACLE_MIN_GAP_CM 100
+#define OBSTACLE_MAX_GAP_CM 250
+#define OBSTACLE_RADIUS_CM 5
+#define OBSTACLE_IN_PATH_CM 4
+#define OBSTACLE_SIDE_MIN_CM 25
+#define OBSTACLE_SIDE_MAX_CM 45
+#define OBSTACLE_CLEAR_US 1000000
+#define OBSTACLE_CLEAR_RANGE_CM 40
+#define RUN_TIMEOUT_US 600000000ULL
+
+#define DEFAULT_RUNS 20
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+/*
+ * @brief Outcome of one pass down the course
+ */
+struct courseResult {
+	double seconds;
+	uint32_t impacts;
+	bool finished;
+};
+
+static uint64_t stoppedSinceUs;
+
+static void courseTick(uint64_t fromUs, uint64_t toUs) {
+	worldTick(fromUs, toUs);
+
+	if (fabs(worldSpeed()) > 1) {
+		stoppedSinceUs = toUs;
+		return;
+	}
+	if (toUs - stoppedSinceUs < OBSTACLE_CLEAR_US)
+		return;
+
+	// Been waiting long enough, clear whatever is right in front of the robot
+	for (int i = 0; i < world.numObstacles; i++) {
+		worldObstacle* obstacle = &world.obstacles[i];
+		double ahead = obstacle->x - world.robot.x - obstacle->radius - WORLD_HALF_WIDTH_CM;
+		if (obstacle->active && ahead < OBSTACLE_CLEAR_RANGE_CM)
+			obstacle->active = false;
+	}
+	stoppedSinceUs = toUs;
+}
+
+static void buildCourse(std::mt19937& rng) {
+	std::uniform_real_distribution<double> gap(OBSTACLE_MIN_GAP_CM, OBSTACLE_MAX_GAP_CM);
+	std::uniform_real_distribution<double> inPath(-OBSTACLE_IN_PATH_CM, OBSTACLE_IN_PATH_CM);
+	std::uniform_real_distribution<double> aside(OBSTACLE_SIDE_MIN_CM, OBSTACLE_SIDE_MAX_CM);
+
+	for (double x = gap(rng); x < COURSE_CM && world.numObstacles < WORLD_MAX_OBSTACLES; x += gap(rng)) {
+		double y;
+		switch (rng() % 3) {
+			case 0: y = inPath(rng); break;
+			case 1: y = aside(rng); break;
+			default: y = -aside(rng); break;
+		}
+		worldAddObstacle(x, y, OBSTACLE_RADIUS_CM, 0, 0);
+	}
+}
+
+static courseResult runCourse(ROBOT_SPEED speed, unsigned seed) {
+	std::mt19937 rng(seed);
+
+	simReset();
+	worldReset();
+	sim.onTick = courseTick;
+	stoppedSinceUs = 0;
+	world.drivePhotodiodes = false;
+	buildCourse(rng);
+
+	// Light dead ahead on every diode, so the robot only ever drives straight
+	sim.analog[PHOTODIODE_TOP_LEFT] = 700;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = 700;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = 700;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = 700;
+	sim.capTau = 50;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = speed;
+	initPins();
+	initServo();
+	// The world's wheels are matched, so the default trim would only steer it off the course
+	setMotorBalance(0);
+
+	while (world.robot.x < COURSE_CM && sim.timeUs < RUN_TIMEOUT_US) {
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+	}
+
+	return {sim.timeUs / 1e6, world.impacts, world.robot.x >= COURSE_CM};
+}
+
+int main(int argc, char** argv) {
+	int runs = DEFAULT_RUNS;
+	unsigned seed = 240;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+			runs = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = (unsigned) strtoul(argv[++i], NULL, 10);
+		} else {
+			fprintf(stderr, "usage: obstacle_course [--runs N] [--seed S]\n");
+			return 2;
+		}
+	}
+
+	const ROBOT_SPEED speeds[] = {SLOW, MEDIUM, FAST};
+	const char* speedNames[] = {"SLOW", "MEDIUM", "FAST"};
+
+#ifdef COLLISION_FIXED_STOP
+	printf("Braking: fixed COLLISION_DISTANCE stop (%d cm)\n", COLLISION_DISTANCE);
+#else
+	printf("Braking: time-to-collision (stop %d ms, slow %d ms)\n", TTC_STOP_MS, TTC_SLOW_MS);
+#endif
+	printf("%-7s %6s %12s %9s %10s\n", "speed", "runs", "avg cm/s", "impacts", "unfinished");
+
+	for (int s = 0; s < 3; s++) {
+		double totalSeconds = 0;
+		uint32_t impacts = 0;
+		int unfinished = 0;
+
+		for (int run = 0; run < runs; run++) {
+			courseResult result = runCourse(speeds[s], seed + run);
+			totalSeconds += result.seconds;
+			impacts += result.impacts;
+			if (!result.finished)
+				unfinished++;
+		}
+
+		printf("%-7s %6d %12.1f %9u %10d\n", speedNames[s], runs, COURSE_CM * runs / totalSeconds, impacts, unfinished);
+	}
+
+	return 0;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file pin_telemetry_bench.cpp
+ *
+ * @brief Link use of the pin voltage summaries, and whether short spikes make it through.
+ *
+ * Built with the telemetry profile. The robot is parked with the light straight ahead for RUN_S
+ * simulated seconds while spikes of SPIKE_US go through the top left photodiode at random times,
+ * one every other summary window. Every byte sent down the link is decoded on the way, and
+ * the spike counts as caught when the maximum of its window's summary reaches it, and as visible
+ * in the mean when the mean gets halfway to it.
+ *
+ * Reports the bytes per second the summaries took, against sending every reading as its own
+ * sendPinData() frame. The link is 9600 baud and sending blocks the loop once the TX buffer is
+ * full, so a spike that comes and goes while it is blocked is never read at all.
+ *
+ * Built twice by `make pin-telemetry`: once as is, and once with PIN_AGGREGATE_HISTOGRAM defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <random>
+
+#include "includes.h"
+#include "frame_decoder.h"
+
+#define RUN_S 30
+#define ADC_STEADY 600
+#define ADC_SPIKE 1000
+#define SPIKE_US 20000
+#define CAP_UNTOUCHED 50
+#define PIN_DATA_FRAME_BYTES 6
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+static struct {
+	uint8_t frame[1 + DATA_BLOB_DATA_SIZE];
+	int length;
+	uint32_t totalBytes;
+	uint32_t summaryBytes;
+	uint32_t histogramBytes;
+	uint32_t summaries;
+	uint32_t readings;		// readings of the spiked pin the summaries covered
+	uint32_t caught;
+	uint32_t inMean;
+} link;
+
+static uint64_t spikeOffUs;
+static uint32_t spikes = 0;
+static uint32_t lastCaught = 0;		// a spike straddling two windows shows in both
+
+static void spikeOn() {
+	spikes++;
+	sim.analog[PHOTODIODE_TOP_LEFT] = ADC_SPIKE;
+	simSchedule(spikeOffUs, [] { sim.analog[PHOTODIODE_TOP_LEFT] = ADC_STEADY; });
+}
+
+static void decodeFrame() {
+	uint8_t header = link.frame[0];
+	uint32_t frameBytes = 1 + framePayloadLength(header);
+
+	if (header == PIN_HISTOGRAM_DATA_BLOB_HEADER)
+		link.histogramBytes += frameBytes;
+	if (header != PIN_SUMMARY_DATA_BLOB_HEADER)
+		return;
+
+	link.summaryBytes += frameBytes;
+	if (link.frame[1] != PHOTODIODE_TOP_LEFT)
+		return;
+
+	uint16_t max = link.frame[5] | (link.frame[6] << 8);
+	uint16_t mean = link.frame[7] | (link.frame[8] << 8);
+	link.summaries++;
+	link.readings += link.frame[2];
+	if (max >= ADC_SPIKE && lastCaught != spikes) {
+		lastCaught = spikes;
+		link.caught++;
+		if (mean >= (ADC_STEADY + ADC_SPIKE) / 2)
+			link.inMean++;
+	}
+}
+
+static void onSerial(uint8_t byte, uint64_t timeUs) {
+	(void) timeUs;
+	link.totalBytes++;
+
+	// Waiting for a header
+	if (link.length == 0 && framePayloadLength(byte) == 0)
+		return;
+
+	link.frame[link.length++] = byte;
+	if (link.length == 1 + framePayloadLength(link.frame[0])) {
+		decodeFrame();
+		link.length = 0;
+	}
+}
+
+int main() {
+#ifdef PIN_AGGREGATE_HISTOGRAM
+	printf("Pin summaries: every %d ms, with histograms\n", PIN_AGGREGATE_WINDOW_MS);
+#else
+	printf("Pin summaries: every %d ms\n", PIN_AGGREGATE_WINDOW_MS);
+#endif
+
+	simReset();
+	sim.capTau = CAP_UNTOUCHED;
+	sim.onSerial = onSerial;
+	sim.analog[PHOTODIODE_TOP_LEFT] = ADC_STEADY;
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = ADC_STEADY;
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = ADC_STEADY;
+	sim.analog[PHOTODIODE_TOP_RIGHT] = ADC_STEADY;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = STOPPED;
+	initPins();
+	initSerialComm();
+	initServo();
+
+	std::mt19937 rng(240);
+	std::uniform_int_distribution<uint32_t> phase(0, PIN_AGGREGATE_WINDOW_MS * 1000 - SPIKE_US);
+
+	// One spike somewhere in every other window, so no two land in the same one
+	uint64_t windowUs = PIN_AGGREGATE_WINDOW_MS * 1000ULL;
+	uint64_t nextWindowUs = 2 * windowUs;
+
+	uint64_t startUs = sim.timeUs;
+	uint64_t endUs = startUs + RUN_S * 1000000ULL;
+	while (sim.timeUs < endUs) {
+		if (!sim.onEvent && sim.timeUs >= nextWindowUs - windowUs && nextWindowUs + windowUs < endUs) {
+			uint64_t onUs = nextWindowUs + phase(rng);
+			spikeOffUs = onUs + SPIKE_US;
+			simSchedule(onUs, spikeOn);
+			nextWindowUs += 2 * windowUs;
+		}
+
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+	}
+
+	double seconds = (sim.timeUs - startUs) / 1e6;
+	printf("link %.0f B/s, summaries %.0f B/s, histograms %.0f B/s\n", link.totalBytes / seconds,
+			link.summaryBytes / seconds, link.histogramBytes / seconds);
+	printf("every reading as its own frame would take %.0f B/s for that pin alone\n",
+			link.readings * PIN_DATA_FRAME_BYTES / seconds);
+	printf("spikes %u: caught in the max %u, visible in the mean %u\n", spikes, link.caught, link.inMean);
+	return 0;
+}
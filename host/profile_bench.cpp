@@ -0,0 +1,87 @@
+/**
+ * @file profile_bench.cpp
+ *
+ * @brief Loop time of one build profile, see profiles.h.
+ *
+ * Drives the simulated robot towards a light drifting across its path for RUN_S simulated seconds
+ * and reports how long loop() takes, in us and in cycles at 16 MHz. The times are the modelled
+ * cost of each hardware call in the shims, serial bytes once the TX buffer fills up, and the
+ * sampling profiler's interrupt.
+ *
+ * Code that doesn't call the hardware takes no time in the shims, so the planning phase, the
+ * float math elsewhere and the serial TX interrupt aren't in the loop time. It doesn't split the
+ * loop by phase for that reason: planning would always read 0.
+ *
+ * `make profiles` builds and runs it once per profile. Flash and SRAM come from the firmware build
+ * itself, `make race`, `make standard`, `make telemetry` or `make debug`, and aren't measured here.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+#include "includes.h"
+#include "world.h"
+
+#define RUN_S 8
+#define LIGHT_START_CM 300
+#define LIGHT_HEIGHT_CM 80		// straight ahead of the array at SERVO_ANGLE_START
+#define LIGHT_DRIFT_CMPS 5
+#define CPU_MHZ 16
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+static const char* speedNames[] = {"STOPPED", "SLOW", "MEDIUM", "FAST"};
+
+static const char* speedName(ROBOT_SPEED speed) {
+	switch (speed) {
+		case SLOW: return speedNames[1];
+		case MEDIUM: return speedNames[2];
+		case FAST: return speedNames[3];
+		default: return speedNames[0];
+	}
+}
+
+int main() {
+	simReset();
+	worldReset();
+	world.light = {LIGHT_START_CM, -LIGHT_DRIFT_CMPS * RUN_S / 2.0, LIGHT_HEIGHT_CM, 0, LIGHT_DRIFT_CMPS, true};
+	sim.capTau = 50;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = ROBOT_START_SPEED;
+	initPins();
+	initSerialComm();
+	initProfiler();
+	initServo();
+	setMotorBalance(0);
+
+	std::vector<double> loopUs;
+
+	uint64_t startUs = sim.timeUs;
+	while (sim.timeUs < startUs + RUN_S * 1000000ULL) {
+		uint64_t t0 = sim.timeUs;
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+		loopUs.push_back((double) (sim.timeUs - t0));
+	}
+
+	size_t loops = loopUs.size();
+	double mean = (double) (sim.timeUs - startUs) / loops;
+	std::sort(loopUs.begin(), loopUs.end());
+
+	printf("Profile: %s, driving %s, %.0f cm in %d s\n", PROFILE_NAME, speedName(robotSpeed), world.distanceCm, RUN_S);
+	printf("%-8s %10s %10s %12s\n", "loops", "loop us", "p99 us", "loop cyc");
+	printf("%-8zu %10.1f %10.1f %12.0f\n", loops, mean, loopUs[loops * 99 / 100], mean * CPU_MHZ);
+	return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file profiler_bench.cpp
+ *
+ * @brief Host only run of the sampling profiler, see profiler.h.
+ *
+ * Built with the sampling profile. Drives the simulated robot towards a light drifting across
+ * its path for RUN_S simulated seconds with the profiler running, and writes every byte the
+ * firmware sends down the serial link to the capture file. The samples are the host addresses
+ * of the hardware calls the simulated clock was in, so `profileSymbols.py` can symbolize the
+ * capture against this binary with the host nm, just as it would a capture off the robot
+ * against the .elf.
+ *
+ * Exits non-zero if the samples, sent and dropped, don't add up to PROFILER_RATE_HZ.
+ *
+ * Only time the shims model shows up: the sonar, ADC, capacitive sensor, servo, serial and
+ * sleep. Code running between hardware calls takes no simulated time, so the soft-float
+ * routines only show on the robot.
+ *
+ * The PCs come from sim.interruptedPc. The AVR interrupt, and its read of the return address off
+ * the stack, never runs here. `make profiler-isr` checks that read in the firmware instead.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+#include "world.h"
+
+#define RUN_S 20
+#define LIGHT_START_CM 300
+#define LIGHT_HEIGHT_CM 80
+#define LIGHT_DRIFT_CMPS 5
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+static FILE* capture;
+static uint32_t capturedBytes = 0;
+static uint8_t frame[1 + DATA_BLOB_DATA_SIZE];
+static uint16_t dropped = 0;
+
+// Only sample frames go down the link in this build, each with the number dropped so far last
+static void captureByte(uint8_t byte, uint64_t timeUs) {
+	(void) timeUs;
+	fputc(byte, capture);
+
+	frame[capturedBytes++ % sizeof(frame)] = byte;
+	if (capturedBytes % sizeof(frame) == 0)
+		dropped = frame[1 + 2 * PROFILER_FRAME_SAMPLES] | (frame[2 + 2 * PROFILER_FRAME_SAMPLES] << 8);
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s <capture file>\n", argv[0]);
+		return 2;
+	}
+
+	capture = fopen(argv[1], "wb");
+	if (!capture) {
+		perror(argv[1]);
+		return 2;
+	}
+
+	simReset();
+	worldReset();
+	world.light = {LIGHT_START_CM, -LIGHT_DRIFT_CMPS * RUN_S / 2.0, LIGHT_HEIGHT_CM, 0, LIGHT_DRIFT_CMPS, true};
+	sim.capTau = 50;
+	sim.onSerial = captureByte;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = ROBOT_START_SPEED;
+	initPins();
+	initSerialComm();
+	initProfiler();
+	initServo();
+	setMotorBalance(0);
+
+	uint64_t startUs = sim.timeUs;
+	while (sim.timeUs < startUs + RUN_S * 1000000ULL) {
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+	}
+	fclose(capture);
+
+	uint32_t frames = capturedBytes / (1 + DATA_BLOB_DATA_SIZE);
+	uint32_t samples = frames * PROFILER_FRAME_SAMPLES;
+	double expected = PROFILER_RATE_HZ * RUN_S;
+	printf("Profiler: %.1f Hz for %d s, %u frames (%u samples, %u dropped) captured to %s\n",
+			PROFILER_RATE_HZ, RUN_S, frames, samples, dropped, argv[1]);
+
+	// Up to a ring's worth can still be waiting to go out
+	if (samples + dropped + PROFILER_RING < expected || samples + dropped > expected + 1) {
+		printf("profiler_bench: sampled at %.1f Hz, not %.1f Hz\n", (samples + dropped) / (double) RUN_S,
+				PROFILER_RATE_HZ);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,372 @@
+/**
+ * @file replay.cpp
+ *
+ * @brief Replays a recorded sensor trace through the robot's control logic on the host.
+ *
+ * Each line of the trace is one pass of loop():
+ *
+ *     time_us,top_left,bottom_left,bottom_right,top_right,sonar_cm,cap_tau
+ *
+ * The photodiode columns are raw ADC counts, sonar_cm is what ping_cm() returned (0 = nothing
+ * in range) and cap_tau is what capacitiveSensor() returned. A header line and blank lines are
+ * skipped. The values are presented on the virtual hardware before RobotDetection() runs and the
+ * clock is pinned to time_us, so the 40 ms sonar gate sees the recorded timing.
+ *
+ * After every frame the actionStates are written as one line, "CC BB DD SS PP II SE TT" in hex
+ * (Collision, Brake, Drive, Servo, Power, Idle, Search, Track). That sequence is either written
+ * out as a new golden file or diffed against one.
+ *
+ *     replay <trace.csv> --write-golden <out.golden>
+ *     replay <trace.csv> --golden <expected.golden>
+ *     replay --record <trace.csv>
+ *
+ * --record runs the sketch against the world model (world.h) for RECORD_S simulated seconds and
+ * writes the inputs of every pass out as a trace: the robot drives at a light drifting across its
+ * path, brakes for an obstacle, is touched, and loses the light for long enough to search.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <chrono>
+
+#include "includes.h"
+#include "world.h"
+
+// time_us, the four photodiodes, sonar_cm, cap_tau
+#define TRACE_FIELDS 7
+#define GOLDEN_NUM_STATES 8
+#define GOLDEN_LINE_LEN (3 * GOLDEN_NUM_STATES)
+#define MAX_REPORTED_DIFFS 10
+
+// The run --record writes out (s, cm, cm/s)
+#define RECORD_S 30
+#define RECORD_LIGHT_X_CM 400
+#define RECORD_LIGHT_Y_CM 60
+#define RECORD_LIGHT_Z_CM 40
+#define RECORD_LIGHT_DRIFT_CMPS -6
+#define RECORD_OBSTACLE_X_CM 90
+#define RECORD_OBSTACLE_RADIUS_CM 6
+#define RECORD_TOUCH_S 5
+#define RECORD_TOUCH_MS 300
+#define RECORD_DARK_S 14
+#define RECORD_DARK_MS 6000
+#define RECORD_CAP_UNTOUCHED 50
+#define RECORD_CAP_TOUCHED 600
+
+extern actionStateStruct actionStates;
+
+/*
+ * @brief One recorded pass of loop()
+ */
+struct traceFrame {
+	uint64_t timeUs;
+	uint16_t photodiode[4];
+	uint16_t sonarCm;
+	long capTau;
+};
+
+static const uint8_t photodiodePins[4] = {
+	PHOTODIODE_TOP_LEFT, PHOTODIODE_BOTTOM_LEFT, PHOTODIODE_BOTTOM_RIGHT, PHOTODIODE_TOP_RIGHT
+};
+
+static char* readFile(const char* path, size_t* size) {
+	FILE* file = fopen(path, "rb");
+	if (!file) {
+		fprintf(stderr, "replay: cannot open %s\n", path);
+		return NULL;
+	}
+
+	fseek(file, 0, SEEK_END);
+	*size = (size_t) ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	char* buf = (char*) malloc(*size + 1);
+	if (fread(buf, 1, *size, file) != *size) {
+		fprintf(stderr, "replay: short read on %s\n", path);
+		free(buf);
+		fclose(file);
+		return NULL;
+	}
+	buf[*size] = '\0';
+
+	fclose(file);
+	return buf;
+}
+
+/*
+ * Parses one number. Returns the character after it, or NULL if there's no number there.
+ */
+static const char* parseField(const char* p, long* out) {
+	long value = 0;
+	bool negative = false;
+
+	while (*p == ' ' || *p == '\t')
+		p++;
+	if (*p == '-') {
+		negative = true;
+		p++;
+	}
+	if (*p < '0' || *p > '9')
+		return NULL;
+	while (*p >= '0' && *p <= '9')
+		value = value * 10 + (*p++ - '0');
+
+	*out = negative ? -value : value;
+	return p;
+}
+
+/*
+ * Parses the comma separated fields of one line. Returns the character after the last one, or
+ * NULL if there are fewer than count.
+ */
+static const char* parseFields(const char* p, long* fields, int count) {
+	for (int i = 0; i < count; i++) {
+		if (i > 0) {
+			if (*p != ',')
+				return NULL;
+			p++;
+		}
+		p = parseField(p, &fields[i]);
+		if (!p)
+			return NULL;
+	}
+	return p;
+}
+
+/*
+ * Parses the trace in place. Returns the number of frames, or -1 on a malformed line.
+ */
+static long parseTrace(const char* text, traceFrame** framesOut) {
+	size_t capacity = 1024;
+	long count = 0;
+	traceFrame* frames = (traceFrame*) malloc(capacity * sizeof(traceFrame));
+	long line = 0;
+
+	if (!frames) {
+		fprintf(stderr, "replay: out of memory\n");
+		return -1;
+	}
+
+	for (const char* p = text; *p; ) {
+		line++;
+		// Skip blank lines and the header
+		if (*p < '0' || *p > '9') {
+			while (*p && *p != '\n')
+				p++;
+			if (*p)
+				p++;
+			continue;
+		}
+
+		long fields[TRACE_FIELDS];
+		const char* end = parseFields(p, fields, TRACE_FIELDS);
+
+		if (!end || (*end != '\n' && *end != '\r' && *end != '\0')) {
+			fprintf(stderr, "replay: malformed trace line %ld\n", line);
+			free(frames);
+			return -1;
+		}
+		p = end;
+		while (*p == '\r' || *p == '\n')
+			p++;
+
+		if ((size_t) count == capacity) {
+			traceFrame* grown = (traceFrame*) realloc(frames, 2 * capacity * sizeof(traceFrame));
+			if (!grown) {
+				fprintf(stderr, "replay: out of memory at trace line %ld\n", line);
+				free(frames);
+				return -1;
+			}
+			frames = grown;
+			capacity *= 2;
+		}
+
+		traceFrame* frame = &frames[count++];
+		frame->timeUs = (uint64_t) fields[0];
+		for (int i = 0; i < 4; i++)
+			frame->photodiode[i] = (uint16_t) fields[1 + i];
+		frame->sonarCm = (uint16_t) fields[5];
+		frame->capTau = fields[6];
+	}
+
+	*framesOut = frames;
+	return count;
+}
+
+static void formatActions(char* out) {
+	static const char hex[] = "0123456789abcdef";
+	uint8_t values[GOLDEN_NUM_STATES] = {actionStates.Collision, actionStates.Brake, actionStates.Drive,
+			actionStates.Servo, actionStates.Power, actionStates.Idle, actionStates.Search, actionStates.Track};
+
+	for (int i = 0; i < GOLDEN_NUM_STATES; i++) {
+		out[3 * i] = hex[values[i] >> 4];
+		out[3 * i + 1] = hex[values[i] & 0xF];
+		out[3 * i + 2] = (i == GOLDEN_NUM_STATES - 1) ? '\n' : ' ';
+	}
+}
+
+static int recordTrace(const char* tracePath) {
+	FILE* out = fopen(tracePath, "w");
+	if (!out) {
+		fprintf(stderr, "replay: cannot write %s\n", tracePath);
+		return 2;
+	}
+	fprintf(out, "time_us,top_left,bottom_left,bottom_right,top_right,sonar_cm,cap_tau\n");
+
+	simReset();
+	worldReset();
+	world.light = {RECORD_LIGHT_X_CM, RECORD_LIGHT_Y_CM, RECORD_LIGHT_Z_CM, 0, RECORD_LIGHT_DRIFT_CMPS, true};
+	worldAddObstacle(RECORD_OBSTACLE_X_CM, 0, RECORD_OBSTACLE_RADIUS_CM, 0, 0);
+	initPins();
+	initServo();
+
+	uint64_t startUs = sim.timeUs;
+	long frames = 0;
+	while (sim.timeUs < startUs + RECORD_S * 1000000ULL) {
+		uint64_t runMs = (sim.timeUs - startUs) / 1000;
+		sim.capTau = (runMs >= RECORD_TOUCH_S * 1000UL && runMs < RECORD_TOUCH_S * 1000UL + RECORD_TOUCH_MS)
+				? RECORD_CAP_TOUCHED : RECORD_CAP_UNTOUCHED;
+		world.light.on = runMs < RECORD_DARK_S * 1000UL || runMs >= RECORD_DARK_S * 1000UL + RECORD_DARK_MS;
+
+		// What the sketch is about to see this pass
+		fprintf(out, "%llu,%u,%u,%u,%u,%u,%ld\n", (unsigned long long) sim.timeUs,
+				sim.analog[PHOTODIODE_TOP_LEFT], sim.analog[PHOTODIODE_BOTTOM_LEFT],
+				sim.analog[PHOTODIODE_BOTTOM_RIGHT], sim.analog[PHOTODIODE_TOP_RIGHT], sim.sonarCm, sim.capTau);
+		frames++;
+
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+	}
+
+	fclose(out);
+	fprintf(stderr, "replay: recorded %ld frames to %s\n", frames, tracePath);
+	return 0;
+}
+
+static void usage() {
+	fprintf(stderr, "usage: replay <trace.csv> (--golden <file> | --write-golden <file>)\n"
+			"       replay --record <trace.csv>\n");
+}
+
+int main(int argc, char** argv) {
+	if (argc == 3 && strcmp(argv[1], "--record") == 0)
+		return recordTrace(argv[2]);
+
+	if (argc != 4) {
+		usage();
+		return 2;
+	}
+
+	const char* tracePath = argv[1];
+	const char* goldenPath = argv[3];
+	bool writeGolden;
+
+	if (strcmp(argv[2], "--golden") == 0) {
+		writeGolden = false;
+	} else if (strcmp(argv[2], "--write-golden") == 0) {
+		writeGolden = true;
+	} else {
+		usage();
+		return 2;
+	}
+
+	size_t traceSize;
+	char* traceText = readFile(tracePath, &traceSize);
+	if (!traceText)
+		return 2;
+
+	traceFrame* frames;
+	long frameCount = parseTrace(traceText, &frames);
+	free(traceText);
+	if (frameCount < 0)
+		return 2;
+
+	size_t goldenSize = 0;
+	char* golden = NULL;
+	if (!writeGolden) {
+		golden = readFile(goldenPath, &goldenSize);
+		if (!golden)
+			return 2;
+	}
+
+	char* actual = (char*) malloc((size_t) frameCount * GOLDEN_LINE_LEN + 1);
+
+	simReset();
+	sim.timeModel = false;
+	initPins();
+	initServo();
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (long i = 0; i < frameCount; i++) {
+		const traceFrame* frame = &frames[i];
+
+		sim.timeUs = frame->timeUs;
+		for (int pd = 0; pd < 4; pd++)
+			sim.analog[photodiodePins[pd]] = frame->photodiode[pd];
+		sim.sonarCm = frame->sonarCm;
+		sim.capTau = frame->capTau;
+
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+
+		formatActions(&actual[i * GOLDEN_LINE_LEN]);
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	fprintf(stderr, "replay: %ld frames in %.3f s (%.2f M frames/s)\n",
+			frameCount, seconds, seconds > 0 ? frameCount / seconds / 1e6 : 0.0);
+
+	size_t actualSize = (size_t) frameCount * GOLDEN_LINE_LEN;
+	int result = 0;
+
+	if (writeGolden) {
+		FILE* out = fopen(goldenPath, "wb");
+		if (!out || fwrite(actual, 1, actualSize, out) != actualSize) {
+			fprintf(stderr, "replay: cannot write %s\n", goldenPath);
+			result = 2;
+		}
+		if (out)
+			fclose(out);
+	} else {
+		long goldenFrames = (long) (goldenSize / GOLDEN_LINE_LEN);
+		long diffs = 0;
+
+		if (goldenSize % GOLDEN_LINE_LEN != 0 || goldenFrames != frameCount) {
+			fprintf(stderr, "replay: golden has %ld frames, trace has %ld\n", goldenFrames, frameCount);
+			diffs++;
+		}
+
+		long common = (goldenFrames < frameCount) ? goldenFrames : frameCount;
+		for (long i = 0; i < common; i++) {
+			const char* want = &golden[i * GOLDEN_LINE_LEN];
+			const char* got = &actual[i * GOLDEN_LINE_LEN];
+			if (memcmp(want, got, GOLDEN_LINE_LEN) == 0)
+				continue;
+
+			if (diffs < MAX_REPORTED_DIFFS)
+				fprintf(stderr, "frame %ld: expected %.*s, got %.*s\n", i, GOLDEN_LINE_LEN - 1, want,
+						GOLDEN_LINE_LEN - 1, got);
+			diffs++;
+		}
+
+		if (diffs) {
+			fprintf(stderr, "replay: %ld frame(s) differ from %s\n", diffs, goldenPath);
+			result = 1;
+		} else {
+			fprintf(stderr, "replay: matches %s\n", goldenPath);
+		}
+	}
+
+	free(actual);
+	free(golden);
+	free(frames);
+	return result;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file search_bench.cpp
+ *
+ * @brief Time for the robot to find a light it can't see, from a random start.
+ *
+ * Each trial puts the light somewhere between LIGHT_MIN_CM and LIGHT_MAX_CM away, behind the
+ * robot and at a random height, so none of the photodiodes can see it. The robot drives at
+ * SEARCH_BENCH_SPEED with the world model driving the photodiodes, and the time until any of
+ * the light flags is set is the time to acquire. A trial that hasn't acquired the light after
+ * TRIAL_TIMEOUT_US counts as a failure.
+ *
+ * Built twice by `make search`: once as is, and once with LIGHT_NO_SEARCH defined.
+ *
+ *     search_bench [--trials N] [--seed S]
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "includes.h"
+#include "world.h"
+
+#define LIGHT_MIN_CM 100
+#define LIGHT_MAX_CM 500
+#define LIGHT_MIN_HEIGHT_CM -20
+#define LIGHT_MAX_HEIGHT_CM 120
+// Bearing of the light, either side of straight behind (deg)
+#define LIGHT_BEHIND_SPREAD_DEG 90
+#define TRIAL_TIMEOUT_US 60000000ULL
+#define SEARCH_BENCH_SPEED SLOW
+#define CAP_UNTOUCHED 50
+
+#define DEFAULT_TRIALS 100
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+static bool lightDetected() {
+	return detectedData.lightDetected.left || detectedData.lightDetected.right
+			|| detectedData.lightDetected.up || detectedData.lightDetected.down;
+}
+
+/*
+ * Runs one trial and returns the time to acquire in us, or -1 if the light wasn't found.
+ */
+static long runTrial(std::mt19937& rng, double* rangeCm) {
+	std::uniform_real_distribution<double> range(LIGHT_MIN_CM, LIGHT_MAX_CM);
+	std::uniform_real_distribution<double> height(LIGHT_MIN_HEIGHT_CM, LIGHT_MAX_HEIGHT_CM);
+	std::uniform_real_distribution<double> behind(-LIGHT_BEHIND_SPREAD_DEG, LIGHT_BEHIND_SPREAD_DEG);
+	std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+
+	simReset();
+	worldReset();
+	sim.capTau = CAP_UNTOUCHED;
+
+	world.robot.heading = heading(rng);
+	double bearing = world.robot.heading + M_PI + behind(rng) * M_PI / 180.0;
+	*rangeCm = range(rng);
+	world.light = {*rangeCm * cos(bearing), *rangeCm * sin(bearing), height(rng), 0, 0, true};
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = SEARCH_BENCH_SPEED;
+	initPins();
+	initServo();
+
+	uint64_t startUs = sim.timeUs;
+	while (sim.timeUs < startUs + TRIAL_TIMEOUT_US) {
+		RobotDetection();
+		if (lightDetected())
+			return (long) (sim.timeUs - startUs);
+		RobotPlanning();
+		RobotAction();
+	}
+	return -1;
+}
+
+// Failed trials sort last, so a percentile that lands on one reads as a timeout
+static void printPercentiles(const char* name, std::vector<long> times) {
+	std::sort(times.begin(), times.end());
+	size_t found = std::count_if(times.begin(), times.end(), [](long us) { return us >= 0; });
+	std::rotate(times.begin(), times.begin() + (times.size() - found), times.end());
+
+	printf("%-10s %5zu/%-3zu", name, found, times.size());
+	for (double p : {0.5, 0.9}) {
+		size_t index = (size_t) (p * (times.size() - 1) + 0.5);
+		if (times.empty() || times[index] < 0)
+			printf(" %9s", "timeout");
+		else
+			printf(" %9.2f", times[index] / 1e6);
+	}
+	printf("\n");
+}
+
+int main(int argc, char** argv) {
+	int trials = DEFAULT_TRIALS;
+	unsigned seed = 240;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+			trials = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = (unsigned) strtoul(argv[++i], NULL, 10);
+		} else {
+			fprintf(stderr, "usage: search_bench [--trials N] [--seed S]\n");
+			return 2;
+		}
+	}
+
+#ifdef LIGHT_NO_SEARCH
+	printf("Light search: off\n");
+#else
+	printf("Light search: scan %d ms, approach %d ms, give up after %d ms\n",
+			SEARCH_SCAN_MS, SEARCH_APPROACH_MS, SEARCH_TIMEOUT_MS);
+#endif
+
+	std::mt19937 rng(seed);
+	std::vector<long> all, near, far;
+	// Split at the middle of the range, the far half mostly has to be driven towards first
+	const double nearCm = (LIGHT_MIN_CM + LIGHT_MAX_CM) / 2.0;
+
+	for (int trial = 0; trial < trials; trial++) {
+		double rangeCm;
+		long us = runTrial(rng, &rangeCm);
+		all.push_back(us);
+		(rangeCm < nearCm ? near : far).push_back(us);
+	}
+
+	printf("%-10s %9s %9s %9s\n", "light", "acquired", "p50 s", "p90 s");
+	printPercentiles("all", all);
+	printPercentiles("near", near);
+	printPercentiles("far", far);
+	return 0;
+}
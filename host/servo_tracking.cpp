@@ -0,0 +1,131 @@
+/**
+ * @file servo_tracking.cpp
+ *
+ * @brief Measures how well the servo keeps the photodiode array on a light that jumps in elevation.
+ *
+ * The robot is parked SERVO_TRACK_RANGE_CM from the light, which jumps between a high and
+ * a low position every STEP_PERIOD_US. Each step is timed until the array is back within
+ * SETTLE_DEG of the light. The whole run is done at two loop rates: a fast loop, and a slow
+ * loop caused by a capacitive sensor that takes a long time to charge.
+ *
+ *     servo_tracking [--steps N]
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+
+#include "includes.h"
+#include "world.h"
+
+#define SERVO_TRACK_RANGE_CM 250
+#define LIGHT_HIGH_CM 100
+#define LIGHT_LOW_CM -45
+#define STEP_PERIOD_US 3000000
+// The array can't resolve the light any closer than this at SERVO_TRACK_RANGE_CM
+#define SETTLE_DEG 12.0
+
+#define CAP_TAU_FAST 50
+#define CAP_TAU_SLOW 40000
+
+#define DEFAULT_STEPS 20
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+/*
+ * @brief Tracking statistics for one run
+ */
+static struct {
+	double absErrorIntegral;	// deg * s
+	double seconds;
+	uint64_t stepUs;
+	bool settled;
+	double settleSeconds;
+	int settledSteps;
+	double overshoot;		// furthest the array went past the light after settling (deg)
+	double lastError;
+} track;
+
+static void trackingTick(uint64_t fromUs, uint64_t toUs) {
+	worldTick(fromUs, toUs);
+
+	double dt = (toUs - fromUs) / 1e6;
+	double error = worldLightElevationError();
+	track.absErrorIntegral += fabs(error) * dt;
+	track.seconds += dt;
+
+	if (!track.settled && fabs(error) <= SETTLE_DEG) {
+		track.settled = true;
+		track.settleSeconds += (toUs - track.stepUs) / 1e6;
+		track.settledSteps++;
+		track.lastError = error;
+	} else if (track.settled && error * track.lastError < 0 && fabs(error) > track.overshoot) {
+		track.overshoot = fabs(error);
+	}
+}
+
+static void runTracking(const char* name, long capTau, int steps) {
+	simReset();
+	worldReset();
+	sim.onTick = trackingTick;
+
+	world.light = {SERVO_TRACK_RANGE_CM, 0, LIGHT_HIGH_CM, 0, 0, true};
+	sim.capTau = capTau;
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	robotSpeed = STOPPED;
+	initPins();
+	initServo();
+	uint32_t initialWrites = sim.servoWrites;
+	memset(&track, 0, sizeof(track));
+
+	uint64_t loops = 0;
+	for (int step = 0; step < steps; step++) {
+		world.light.z = (step % 2) ? LIGHT_LOW_CM : LIGHT_HIGH_CM;
+		track.stepUs = sim.timeUs;
+		track.settled = false;
+
+		uint64_t end = sim.timeUs + STEP_PERIOD_US;
+		while (sim.timeUs < end) {
+			RobotDetection();
+			RobotPlanning();
+			RobotAction();
+			loops++;
+		}
+	}
+
+	uint32_t writes = sim.servoWrites - initialWrites;
+	printf("%-5s %9.2f %10.2f %8d/%-3d %10.1f %10.1f %8u\n",
+			name,
+			track.seconds * 1000.0 / loops,
+			track.absErrorIntegral / track.seconds,
+			track.settledSteps, steps,
+			track.settledSteps ? 1000.0 * track.settleSeconds / track.settledSteps : 0.0,
+			track.overshoot,
+			writes);
+}
+
+int main(int argc, char** argv) {
+	int steps = DEFAULT_STEPS;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+			steps = atoi(argv[++i]);
+		} else {
+			fprintf(stderr, "usage: servo_tracking [--steps N]\n");
+			return 2;
+		}
+	}
+
+	printf("%-5s %9s %10s %12s %10s %10s %8s\n", "loop", "loop ms", "mean err", "settled", "settle ms", "overshoot", "writes");
+	runTracking("fast", CAP_TAU_FAST, steps);
+	runTracking("slow", CAP_TAU_SLOW, steps);
+	return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file Arduino.h
+ *
+ * @brief Host stand-in for the Arduino core, backed by the virtual hardware in sim_hardware.h
+ *
+ * Only the parts of the core the robot firmware actually uses are provided.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.1
+ */
+
+#ifndef __HOST_ARDUINO_H__
+#define __HOST_ARDUINO_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#include "sim_hardware.h"
+
+// Set on the command line by the Arduino build
+#define F_CPU 16000000UL
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define LED_BUILTIN 13
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interruptNum, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+/*
+ * @brief Serial port that only models transmit time, nothing is printed
+ */
+class HardwareSerial {
+public:
+	void begin(unsigned long baud) { (void) baud; }
+	size_t write(uint8_t byte);
+	int availableForWrite();
+	size_t print(const char* msg);
+	size_t println(const char* msg);
+	size_t print(long value);
+	size_t println(long value);
+	size_t println(unsigned long value) { return println((long) value); }
+	size_t println(int value) { return println((long) value); }
+	size_t println(unsigned int value) { return println((long) value); }
+	size_t print(unsigned long value) { return print((long) value); }
+	size_t print(int value) { return print((long) value); }
+	size_t print(unsigned int value) { return print((long) value); }
+	int available() { return 0; }
+	int read() { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+#endif  // __HOST_ARDUINO_H__
@@ -0,0 +1,22 @@
+/**
+ * @file CapacitiveSensor.h
+ *
+ * @brief Host stand-in for the CapacitiveSensor library
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_CAPACITIVE_SENSOR_H__
+#define __HOST_CAPACITIVE_SENSOR_H__
+
+#include "Arduino.h"
+
+class CapacitiveSensor {
+public:
+	CapacitiveSensor(uint8_t sendPin, uint8_t receivePin) { (void) sendPin; (void) receivePin; }
+	long capacitiveSensor(uint8_t samples);
+};
+
+#endif  // __HOST_CAPACITIVE_SENSOR_H__
@@ -0,0 +1,25 @@
+/**
+ * @file NewPing.h
+ *
+ * @brief Host stand-in for the NewPing ultrasonic library
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_NEWPING_H__
+#define __HOST_NEWPING_H__
+
+#include "Arduino.h"
+
+class NewPing {
+public:
+	NewPing(uint8_t triggerPin, uint8_t echoPin, unsigned int maxCmDistance = 500);
+	unsigned long ping_cm(unsigned int maxCmDistance = 0);
+
+private:
+	unsigned int maxCm;
+};
+
+#endif  // __HOST_NEWPING_H__
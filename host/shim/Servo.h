@@ -0,0 +1,29 @@
+/**
+ * @file Servo.h
+ *
+ * @brief Host stand-in for the Arduino Servo library
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_SERVO_H__
+#define __HOST_SERVO_H__
+
+#include "Arduino.h"
+
+class Servo {
+public:
+	uint8_t attach(int pin) { this->pin = pin; return 0; }
+	void detach() {}
+	void write(int angle);
+	void writeMicroseconds(int us);
+	int read();
+	bool attached() { return true; }
+
+private:
+	int pin = 0;
+};
+
+#endif  // __HOST_SERVO_H__
@@ -0,0 +1,59 @@
+/**
+ * @file eeprom.h
+ *
+ * @brief Host stand-in for avr/eeprom.h
+ *
+ * The EEPROM is the simEeprom array, addressed by the pointer value like on the AVR. Reads
+ * cost SIM_EEPROM_READ_US a byte, and each byte eeprom_update_*() actually changes costs
+ * SIM_EEPROM_WRITE_US and counts against that cell in simEepromWrites.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_AVR_EEPROM_H__
+#define __HOST_AVR_EEPROM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sim_hardware.h"
+
+#define E2END (SIM_EEPROM_SIZE - 1)
+
+static inline uint8_t eeprom_read_byte(const uint8_t* addr) {
+	simAdvance(SIM_EEPROM_READ_US);
+	return simEeprom[(uintptr_t) addr % SIM_EEPROM_SIZE];
+}
+
+static inline uint16_t eeprom_read_word(const uint16_t* addr) {
+	const uint8_t* bytes = (const uint8_t*) addr;
+	return eeprom_read_byte(bytes) | (uint16_t) eeprom_read_byte(bytes + 1) << 8;
+}
+
+static inline void eeprom_read_block(void* dst, const void* src, size_t n) {
+	for (size_t i = 0; i < n; i++)
+		((uint8_t*) dst)[i] = eeprom_read_byte((const uint8_t*) src + i);
+}
+
+static inline void eeprom_update_byte(uint8_t* addr, uint8_t value) {
+	uintptr_t cell = (uintptr_t) addr % SIM_EEPROM_SIZE;
+
+	simAdvance(SIM_EEPROM_READ_US);
+	if (simEeprom[cell] == value)
+		return;
+
+	simEeprom[cell] = value;
+	simEepromWrites[cell]++;
+	simAdvance(SIM_EEPROM_WRITE_US);
+}
+
+static inline void eeprom_update_block(const void* src, void* dst, size_t n) {
+	for (size_t i = 0; i < n; i++)
+		eeprom_update_byte((uint8_t*) dst + i, ((const uint8_t*) src)[i]);
+}
+
+#endif  // __HOST_AVR_EEPROM_H__
@@ -0,0 +1,29 @@
+/**
+ * @file interrupt.h
+ *
+ * @brief Host stand-in for avr/interrupt.h
+ *
+ * Interrupt vectors are ordinary functions on the host. The virtual hardware calls them
+ * directly when the event they stand for is simulated.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_AVR_INTERRUPT_H__
+#define __HOST_AVR_INTERRUPT_H__
+
+#include <avr/io.h>
+
+#define SREG_I 7
+
+#define cli() (SREG &= (uint8_t) ~_BV(SREG_I))
+#define sei() (SREG |= _BV(SREG_I))
+
+#define ISR(vector, ...) extern "C" void vector(void); extern "C" void vector(void)
+#define EMPTY_INTERRUPT(vector) extern "C" void vector(void) {}
+
+#endif  // __HOST_AVR_INTERRUPT_H__
@@ -0,0 +1,147 @@
+/**
+ * @file io.h
+ *
+ * @brief Host stand-in for the ATmega328P I/O registers.
+ *
+ * Registers are plain variables. The pin outputs the sketch produces are derived from
+ * the port and timer registers by simSyncOutputs(), the same way the hardware would
+ * route them, so code that pokes registers directly is observed like analogWrite(). Direct
+ * writes are picked up on the next hardware call, which is when the simulated clock moves.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_AVR_IO_H__
+#define __HOST_AVR_IO_H__
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+// Ports
+extern volatile uint8_t PORTB, PORTC, PORTD;
+extern volatile uint8_t DDRB, DDRC, DDRD;
+extern volatile uint8_t PINB, PINC, PIND;
+
+// Timer/counter 0, 1 and 2
+extern volatile uint8_t TCCR0A, TCCR0B, OCR0A, OCR0B, TIMSK0, TIFR0, TCNT0;
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+extern volatile uint16_t OCR1A, OCR1B, ICR1, TCNT1;
+extern volatile uint8_t TCCR2A, TCCR2B, OCR2A, OCR2B, TIMSK2, TCNT2, ASSR;
+
+// ADC
+extern volatile uint8_t ADMUX, ADCSRA;
+extern volatile uint16_t ADC;
+
+// Watchdog and reset flags
+extern volatile uint8_t WDTCSR, MCUSR;
+
+// Status register and stack pointer
+extern volatile uint8_t SREG;
+extern volatile uint16_t SP;
+
+#define PORTB0 0
+#define PORTB1 1
+#define PORTB2 2
+#define PORTB3 3
+#define PORTB4 4
+#define PORTB5 5
+#define PORTC0 0
+#define PORTC1 1
+#define PORTC2 2
+#define PORTC3 3
+#define PORTC4 4
+#define PORTC5 5
+#define PORTD0 0
+#define PORTD1 1
+#define PORTD2 2
+#define PORTD3 3
+#define PORTD4 4
+#define PORTD5 5
+#define PORTD6 6
+#define PORTD7 7
+
+// TCCRnA compare output and waveform bits
+#define COM0A1 7
+#define COM0A0 6
+#define COM0B1 5
+#define COM0B0 4
+#define WGM01 1
+#define WGM00 0
+#define COM1A1 7
+#define COM1A0 6
+#define COM1B1 5
+#define COM1B0 4
+#define WGM11 1
+#define WGM10 0
+#define COM2A1 7
+#define COM2A0 6
+#define COM2B1 5
+#define COM2B0 4
+#define WGM21 1
+#define WGM20 0
+
+// TCCRnB clock select and waveform bits
+#define WGM02 3
+#define CS02 2
+#define CS01 1
+#define CS00 0
+#define WGM13 4
+#define WGM12 3
+#define CS12 2
+#define CS11 1
+#define CS10 0
+#define WGM22 3
+#define CS22 2
+#define CS21 1
+#define CS20 0
+
+// TIMSKn interrupt enables
+#define OCIE0B 2
+#define OCIE0A 1
+#define TOIE0 0
+#define OCIE2B 2
+#define OCIE2A 1
+#define TOIE2 0
+
+// TIFRn interrupt flags
+#define OCF0B 2
+#define OCF0A 1
+#define TOV0 0
+
+// ADMUX reference and channel bits
+#define REFS1 7
+#define REFS0 6
+#define MUX_MASK 0x0F
+
+// ADCSRA control bits
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+
+// WDTCSR control bits
+#define WDIF 7
+#define WDIE 6
+#define WDP3 5
+#define WDCE 4
+#define WDE 3
+#define WDP2 2
+#define WDP1 1
+#define WDP0 0
+
+// MCUSR reset flags
+#define WDRF 3
+#define BORF 2
+#define EXTRF 1
+#define PORF 0
+
+#endif  // __HOST_AVR_IO_H__
@@ -0,0 +1,27 @@
+/**
+ * @file pgmspace.h
+ *
+ * @brief Host stand-in for avr/pgmspace.h
+ *
+ * The host has one address space, so PROGMEM is a no-op and the reads are plain loads.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_AVR_PGMSPACE_H__
+#define __HOST_AVR_PGMSPACE_H__
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr) (*(const uint8_t*) (addr))
+#define pgm_read_word(addr) (*(const uint16_t*) (addr))
+#define pgm_read_dword(addr) (*(const uint32_t*) (addr))
+
+#endif  // __HOST_AVR_PGMSPACE_H__
@@ -0,0 +1,23 @@
+/**
+ * @file power.h
+ *
+ * @brief Host stand-in for avr/power.h
+ *
+ * The peripherals don't draw anything on the host, so switching them off does nothing.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_AVR_POWER_H__
+#define __HOST_AVR_POWER_H__
+
+#define power_twi_disable()
+#define power_spi_disable()
+#define power_twi_enable()
+#define power_spi_enable()
+
+#endif  // __HOST_AVR_POWER_H__
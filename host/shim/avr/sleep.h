@@ -0,0 +1,33 @@
+/**
+ * @file sleep.h
+ *
+ * @brief Host stand-in for avr/sleep.h
+ *
+ * sleep_cpu() skips the simulated clock ahead to the next interrupt and counts the time as
+ * asleep, whatever mode was set. In SLEEP_MODE_ADC a conversion started with ADSC finishes
+ * during the sleep, without the CPU noise, see simSleep(). Sleeping with interrupts off is not
+ * modelled.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_AVR_SLEEP_H__
+#define __HOST_AVR_SLEEP_H__
+
+#include "sim_hardware.h"
+
+#define SLEEP_MODE_IDLE 0
+#define SLEEP_MODE_ADC 1
+#define SLEEP_MODE_PWR_DOWN 2
+#define SLEEP_MODE_PWR_SAVE 3
+
+#define set_sleep_mode(mode) (sim.sleepMode = (mode))
+#define sleep_enable()
+#define sleep_disable()
+#define sleep_cpu() simSleep()
+
+#endif  // __HOST_AVR_SLEEP_H__
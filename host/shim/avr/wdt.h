@@ -0,0 +1,43 @@
+/**
+ * @file wdt.h
+ *
+ * @brief Host stand-in for avr/wdt.h
+ *
+ * The watchdog times out on the simulated clock, see simAdvance(): with WDIE set it runs
+ * WDT_vect and clears WDIE, and with WDE set the timeout after that is a reset, counted in
+ * sim.watchdogResets and handed to sim.onWatchdogReset.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_AVR_WDT_H__
+#define __HOST_AVR_WDT_H__
+
+#include <avr/io.h>
+#include "sim_hardware.h"
+
+#define WDTO_15MS 0
+#define WDTO_30MS 1
+#define WDTO_60MS 2
+#define WDTO_120MS 3
+#define WDTO_250MS 4
+#define WDTO_500MS 5
+#define WDTO_1S 6
+#define WDTO_2S 7
+#define WDTO_4S 8
+#define WDTO_8S 9
+
+// Reset mode, the timeout's top bit is WDP3
+static inline void wdt_enable(uint8_t timeout) {
+	WDTCSR = _BV(WDE) | ((timeout & 0x08) ? _BV(WDP3) : 0) | (timeout & 0x07);
+	sim.watchdogKickUs = sim.timeUs;
+}
+
+#define wdt_reset() (sim.watchdogKickUs = sim.timeUs)
+#define wdt_disable() (WDTCSR = 0)
+
+#endif  // __HOST_AVR_WDT_H__
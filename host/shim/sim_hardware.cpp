@@ -0,0 +1,710 @@
+/**
+ * @file sim_hardware.cpp
+ *
+ * @brief Implementation of the virtual hardware and the Arduino/library shims on top of it
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.2
+ */
+
+#include "sim_hardware.h"
+#include "Arduino.h"
+#include "Servo.h"
+#include "NewPing.h"
+#include "CapacitiveSensor.h"
+#include <avr/sleep.h>
+
+SimHardware sim;
+HardwareSerial Serial;
+
+uint8_t simEeprom[SIM_EEPROM_SIZE];
+uint32_t simEepromWrites[SIM_EEPROM_SIZE];
+
+volatile uint8_t PORTB, PORTC, PORTD;
+volatile uint8_t DDRB, DDRC, DDRD;
+volatile uint8_t PINB, PINC, PIND;
+volatile uint8_t TCCR0A, TCCR0B, OCR0A, OCR0B, TIMSK0, TIFR0, TCNT0;
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+volatile uint16_t OCR1A, OCR1B, ICR1, TCNT1;
+volatile uint8_t TCCR2A, TCCR2B, OCR2A, OCR2B, TIMSK2, TCNT2, ASSR;
+volatile uint8_t ADMUX, ADCSRA;
+volatile uint16_t ADC;
+volatile uint8_t WDTCSR, MCUSR;
+volatile uint8_t SREG;
+volatile uint16_t SP;
+
+#define NUM_EXTERNAL_INTERRUPTS 2
+
+static void (*interruptHandlers[NUM_EXTERNAL_INTERRUPTS])(void);
+static int interruptModes[NUM_EXTERNAL_INTERRUPTS];
+
+/*
+ * @brief Where a Nano pin lives in the port and timer registers
+ */
+struct simPinMap {
+	volatile uint8_t* port;
+	volatile uint8_t* ddr;
+	volatile uint8_t* in;
+	uint8_t bit;
+	volatile uint8_t* tccr;		// timer control register with the compare output bits, NULL if not PWM
+	uint8_t com;			// COMnx1 bit
+};
+
+static const simPinMap pinMap[SIM_NUM_PINS] = {
+	{&PORTD, &DDRD, &PIND, 0, NULL, 0},
+	{&PORTD, &DDRD, &PIND, 1, NULL, 0},
+	{&PORTD, &DDRD, &PIND, 2, NULL, 0},
+	{&PORTD, &DDRD, &PIND, 3, &TCCR2A, COM2B1},
+	{&PORTD, &DDRD, &PIND, 4, NULL, 0},
+	{&PORTD, &DDRD, &PIND, 5, &TCCR0A, COM0B1},
+	{&PORTD, &DDRD, &PIND, 6, &TCCR0A, COM0A1},
+	{&PORTD, &DDRD, &PIND, 7, NULL, 0},
+	{&PORTB, &DDRB, &PINB, 0, NULL, 0},
+	{&PORTB, &DDRB, &PINB, 1, &TCCR1A, COM1A1},
+	{&PORTB, &DDRB, &PINB, 2, &TCCR1A, COM1B1},
+	{&PORTB, &DDRB, &PINB, 3, &TCCR2A, COM2A1},
+	{&PORTB, &DDRB, &PINB, 4, NULL, 0},
+	{&PORTB, &DDRB, &PINB, 5, NULL, 0},
+	{&PORTC, &DDRC, &PINC, 0, NULL, 0},
+	{&PORTC, &DDRC, &PINC, 1, NULL, 0},
+	{&PORTC, &DDRC, &PINC, 2, NULL, 0},
+	{&PORTC, &DDRC, &PINC, 3, NULL, 0},
+	{&PORTC, &DDRC, &PINC, 4, NULL, 0},
+	{&PORTC, &DDRC, &PINC, 5, NULL, 0},
+	{NULL, NULL, NULL, 0, NULL, 0},		// A6 and A7 are analog only
+	{NULL, NULL, NULL, 0, NULL, 0},
+};
+
+static int compareValue(uint8_t pin) {
+	switch (pin) {
+		case 3: return OCR2B;
+		case 5: return OCR0B;
+		case 6: return OCR0A;
+		case 9: return OCR1A;
+		case 10: return OCR1B;
+		case 11: return OCR2A;
+		default: return 0;
+	}
+}
+
+static void setCompareValue(uint8_t pin, uint8_t value) {
+	switch (pin) {
+		case 3: OCR2B = value; break;
+		case 5: OCR0B = value; break;
+		case 6: OCR0A = value; break;
+		case 9: OCR1A = value; break;
+		case 10: OCR1B = value; break;
+		case 11: OCR2A = value; break;
+		default: break;
+	}
+}
+
+#define NOISE_SEED 0x2545F491u
+
+// Same noise every run, for repeatable benches
+static uint32_t noiseState = NOISE_SEED;
+
+static float noiseUniform() {
+	noiseState ^= noiseState << 13;
+	noiseState ^= noiseState >> 17;
+	noiseState ^= noiseState << 5;
+	return (noiseState + 0.5f) / 4294967296.0f;
+}
+
+// Box-Muller
+static float noiseGaussian() {
+	return sqrtf(-2.0f * logf(noiseUniform())) * cosf(2.0f * (float) M_PI * noiseUniform());
+}
+
+/*
+ * One conversion of an analog pin, with adcNoise on it, plus adcCpuNoise unless the CPU was
+ * asleep for it. Noise off draws nothing, so the other benches see exactly the counts they set.
+ */
+static uint16_t convert(uint8_t pin, bool quiet) {
+	uint16_t counts = (pin < SIM_NUM_PINS) ? sim.analog[pin] : 0;
+	float sigma = quiet ? sim.adcNoise : sqrtf(sim.adcNoise * sim.adcNoise + sim.adcCpuNoise * sim.adcCpuNoise);
+	if (sigma <= 0)
+		return counts;
+
+	float noisy = roundf(counts + sigma * noiseGaussian());
+	if (noisy < 0)
+		return 0;
+	if (noisy > 1023)
+		return 1023;
+	return (uint16_t) noisy;
+}
+
+// Defined by the memory monitor, the host's stand-in for its .init1 code
+extern "C" void simInit1(void) __attribute__ ((weak));
+
+// Defined when the sketch converts in ADC noise reduction sleep
+extern "C" void ADC_vect(void) __attribute__ ((weak));
+
+void simReset() {
+	memset(&sim, 0, sizeof(sim));
+	sim.timeModel = true;
+	sim.servoPulseUs = -1;
+	for (int pin = 0; pin < SIM_NUM_PINS; pin++) {
+		sim.pwm[pin] = -1;
+		sim.digitalIn[pin] = HIGH;
+	}
+
+	PORTB = PORTC = PORTD = 0;
+	DDRB = DDRC = DDRD = 0;
+	PINB = PINC = PIND = 0xFF;
+
+	// Timer setup done by the Arduino core's init()
+	TCCR0A = _BV(WGM01) | _BV(WGM00);
+	TCCR0B = _BV(CS01) | _BV(CS00);
+	TIMSK0 = _BV(TOIE0);
+	TCCR1A = _BV(WGM10);
+	TCCR1B = _BV(CS11) | _BV(CS10);
+	TCCR2A = _BV(WGM20);
+	TCCR2B = _BV(CS22);
+	OCR0A = OCR0B = OCR2A = OCR2B = 0;
+	OCR1A = OCR1B = 0;
+	TIMSK1 = TIMSK2 = 0;
+	// ADC on at 125 kHz, as the core leaves it
+	ADMUX = 0;
+	ADCSRA = _BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+	ADC = 0;
+	SREG = 0x80;
+	WDTCSR = 0;
+	MCUSR = _BV(PORF);
+	noiseState = NOISE_SEED;
+
+	for (int i = 0; i < NUM_EXTERNAL_INTERRUPTS; i++)
+		interruptHandlers[i] = NULL;
+
+	SP = SIM_RAMEND - SIM_STACK_DEPTH;
+	if (simInit1)
+		simInit1();
+}
+
+uint8_t* simRamAt(uint16_t address) {
+	return &sim.ram[address - SIM_RAM_START];
+}
+
+void* simMalloc(uint16_t size) {
+	uint16_t chunk = sim.heapBreak ? sim.heapBreak : SIM_HEAP_START;
+	if (chunk + 2 + size > SP - SIM_MALLOC_MARGIN) {
+		sim.mallocFailures++;
+		return NULL;
+	}
+
+	*simRamAt(chunk) = (uint8_t) size;
+	*simRamAt(chunk + 1) = (uint8_t) (size >> 8);
+	sim.heapBreak = chunk + 2 + size;
+	sim.mallocs++;
+	return simRamAt(chunk + 2);
+}
+
+void simFree(void* ptr) {
+	if (!ptr)
+		return;
+
+	uint16_t chunk = SIM_RAM_START + (uint16_t) ((uint8_t*) ptr - sim.ram) - 2;
+	uint16_t size = *simRamAt(chunk) | (*simRamAt(chunk + 1) << 8);
+	if (chunk + 2 + size == sim.heapBreak)
+		sim.heapBreak = chunk;
+}
+
+void simEraseEeprom() {
+	memset(simEeprom, 0xFF, sizeof(simEeprom));
+	memset(simEepromWrites, 0, sizeof(simEepromWrites));
+}
+
+// Erased from the factory
+static struct _eepromEraser {
+	_eepromEraser() { simEraseEeprom(); }
+} eepromEraser;
+
+// Linker-defined start of the image, the profiler's PCs are counted from here
+extern "C" char __executable_start[];
+
+// Defined by the sampling profile only
+extern "C" void TIMER0_COMPA_vect(void) __attribute__ ((weak));
+
+/*
+ * Runs the Timer0 compare A interrupt each time TCNT0 passes OCR0A before untilUs. Timer0
+ * counts up from 0 to 255 every SIM_TIMER0_OVERFLOW_US. In the fast PWM mode the Arduino core
+ * sets it to, OCR0A is double buffered: a write only takes effect at BOTTOM, so the compare
+ * matches at most once per overflow.
+ *
+ * Each interrupt takes SIM_TIMER0_COMPA_US on the clock. Returns the time they took, which the
+ * interrupted code finishes that much later by.
+ */
+static uint64_t runTimer0Compares(uint64_t untilUs, const void* pc) {
+	const uint64_t tickUs = SIM_TIMER0_OVERFLOW_US / 256;
+	uint64_t lastOverflow = untilUs / SIM_TIMER0_OVERFLOW_US;
+	uint64_t spentUs = 0;
+
+	if (!TIMER0_COMPA_vect)
+		return 0;
+
+	for (uint64_t overflow = sim.timeUs / SIM_TIMER0_OVERFLOW_US; overflow <= lastOverflow; ) {
+		bool buffered = (TCCR0A & (_BV(WGM01) | _BV(WGM00))) == (_BV(WGM01) | _BV(WGM00));
+		if (!buffered || overflow > sim.timer0Overflow)
+			sim.ocr0a = OCR0A;
+		sim.timer0Overflow = overflow;
+
+		uint64_t compareUs = (overflow * 256 + sim.ocr0a) * tickUs;
+		if (!(TIMSK0 & _BV(OCIE0A)) || compareUs <= sim.timeUs || compareUs > untilUs) {
+			overflow++;
+			continue;
+		}
+
+		if (sim.onTick)
+			sim.onTick(sim.timeUs, compareUs);
+		sim.timeUs = compareUs;
+
+		sim.interruptedPc = (uint16_t) (((uintptr_t) pc - (uintptr_t) __executable_start) / 2);
+		TIMER0_COMPA_vect();
+
+		if (sim.onTick)
+			sim.onTick(sim.timeUs, sim.timeUs + SIM_TIMER0_COMPA_US);
+		sim.timeUs += SIM_TIMER0_COMPA_US;
+		spentUs += SIM_TIMER0_COMPA_US;
+	}
+
+	return spentUs;
+}
+
+// Defined by the deadline monitor
+extern "C" void WDT_vect(void) __attribute__ ((weak));
+
+static uint64_t watchdogTimeoutUs() {
+	uint8_t prescaler = ((WDTCSR & _BV(WDP3)) ? 8 : 0) | (WDTCSR & 0x07);
+	return (uint64_t) SIM_WATCHDOG_BASE_US << prescaler;
+}
+
+/*
+ * Times the watchdog out each time it goes watchdogTimeoutUs() without a kick before untilUs,
+ * running the Timer0 compares up to each timeout first. Returns the time they took.
+ */
+static uint64_t runWatchdog(uint64_t untilUs, const void* pc) {
+	uint64_t spentUs = 0;
+
+	while (WDTCSR & (_BV(WDE) | _BV(WDIE))) {
+		uint64_t timeout = sim.watchdogKickUs + watchdogTimeoutUs();
+		if (timeout > untilUs)
+			return spentUs;
+
+		spentUs += runTimer0Compares(timeout, pc);
+		if (timeout > sim.timeUs) {
+			if (sim.onTick)
+				sim.onTick(sim.timeUs, timeout);
+			sim.timeUs = timeout;
+		}
+		sim.watchdogKickUs = timeout;
+
+		if (WDTCSR & _BV(WDIE)) {
+			// In interrupt and reset mode the interrupt only runs once
+			if (WDTCSR & _BV(WDE))
+				WDTCSR &= (uint8_t) ~_BV(WDIE);
+			if (WDT_vect)
+				WDT_vect();
+		} else {
+			WDTCSR = 0;
+			MCUSR |= _BV(WDRF);
+			sim.watchdogResets++;
+			if (sim.onWatchdogReset)
+				sim.onWatchdogReset();
+		}
+	}
+
+	return spentUs;
+}
+
+/*
+ * Moves the clock on, firing the pending event and any timer interrupts on the way.
+ * pc is where the time is being spent, reported to the profiler.
+ */
+static void advanceClock(uint64_t us, const void* pc) {
+	uint64_t target = sim.timeUs + us;
+	uint64_t interruptUs = 0;
+
+	// Pick up whatever the sketch wrote to the registers directly since the last call
+	simSyncOutputs();
+
+	// Fire the event at its own time, so an interrupt it raises is stamped correctly
+	if (sim.onEvent && target >= sim.eventAtUs) {
+		interruptUs += runWatchdog(sim.eventAtUs, pc);
+		interruptUs += runTimer0Compares(sim.eventAtUs, pc);
+		if (sim.eventAtUs > sim.timeUs) {
+			if (sim.onTick)
+				sim.onTick(sim.timeUs, sim.eventAtUs);
+			sim.timeUs = sim.eventAtUs;
+		}
+
+		simEventCallback event = sim.onEvent;
+		sim.onEvent = NULL;
+		event();
+	}
+
+	// Time spent in the interrupts is time the call didn't get, so it ends that much later
+	do {
+		target += interruptUs;
+		interruptUs = runWatchdog(target, pc);
+		interruptUs += runTimer0Compares(target, pc);
+	} while (interruptUs);
+
+	if (sim.onTick)
+		sim.onTick(sim.timeUs, target);
+	sim.timeUs = target;
+	TCNT0 = (uint8_t) (sim.timeUs / (SIM_TIMER0_OVERFLOW_US / 256));
+}
+
+/*
+ * For the calls that spin in place on the AVR, so the profiler sees the time spent in them
+ * rather than in their caller.
+ */
+static void __attribute__ ((noinline)) spend(uint64_t us) {
+	advanceClock(us, __builtin_return_address(0));
+}
+
+// Not inlined, so the return address is in the hardware call that spent the time
+void __attribute__ ((noinline)) simAdvance(uint32_t us) {
+	if (sim.timeModel)
+		advanceClock(us, __builtin_return_address(0));
+}
+
+// The AVR wakes up just after the sleep instruction, in its caller
+void __attribute__ ((noinline)) simSleep() {
+	uint64_t wake = (sim.timeUs / SIM_TIMER0_OVERFLOW_US + 1) * SIM_TIMER0_OVERFLOW_US;
+	if (sim.onEvent && sim.eventAtUs > sim.timeUs && sim.eventAtUs < wake)
+		wake = sim.eventAtUs;
+
+	// A conversion the sketch started by setting ADSC runs on from when it was first seen.
+	// ADC noise reduction stops the I/O clock, so Timer0 can't wake it before the end.
+	bool converting = (ADCSRA & _BV(ADEN)) && (ADCSRA & _BV(ADSC));
+	if (converting && !sim.adcDoneUs)
+		sim.adcDoneUs = sim.timeUs + SIM_ADC_CONVERSION_US;
+	if (converting && (sim.adcDoneUs <= wake || sim.sleepMode == SLEEP_MODE_ADC)) {
+		wake = sim.adcDoneUs;
+		if (sim.onEvent && sim.eventAtUs > sim.timeUs && sim.eventAtUs < wake)
+			wake = sim.eventAtUs;
+	}
+
+	sim.sleepUs += wake - sim.timeUs;
+	advanceClock(wake - sim.timeUs, __builtin_return_address(0));
+
+	if (converting && sim.timeUs >= sim.adcDoneUs) {
+		uint8_t channel = ADMUX & MUX_MASK;
+		ADC = convert((channel < 8) ? channel + A0 : channel, sim.sleepMode == SLEEP_MODE_ADC);
+		ADCSRA = (ADCSRA & (uint8_t) ~_BV(ADSC)) | _BV(ADIF);
+		sim.adcDoneUs = 0;
+
+		if (ADC_vect && (ADCSRA & _BV(ADIE))) {
+			ADCSRA &= (uint8_t) ~_BV(ADIF);
+			ADC_vect();
+		}
+	}
+}
+
+void simSchedule(uint64_t atUs, simEventCallback event) {
+	sim.eventAtUs = atUs;
+	sim.onEvent = event;
+}
+
+void simOutput(uint8_t kind, uint8_t pin, int value) {
+	int* last;
+
+	switch (kind) {
+		case SIM_OUTPUT_PWM:
+			last = &sim.pwm[pin];
+			break;
+		case SIM_OUTPUT_SERVO:
+			last = &sim.servoPulseUs;
+			break;
+		default: {
+			int previous = sim.digitalOut[pin];
+			sim.digitalOut[pin] = (uint8_t) value;
+			if (previous != value && sim.onOutput)
+				sim.onOutput(kind, pin, value, sim.timeUs);
+			return;
+		}
+	}
+
+	if (*last != value) {
+		*last = value;
+		if (sim.onOutput)
+			sim.onOutput(kind, pin, value, sim.timeUs);
+	}
+}
+
+void simSyncOutputs() {
+	for (uint8_t pin = 0; pin < SIM_NUM_PINS; pin++) {
+		const simPinMap* map = &pinMap[pin];
+		if (!map->port || !(*map->ddr & _BV(map->bit)))
+			continue;
+
+		bool level = *map->port & _BV(map->bit);
+		if (map->tccr) {
+			bool pwmEnabled = *map->tccr & _BV(map->com);
+			simOutput(SIM_OUTPUT_PWM, pin, pwmEnabled ? compareValue(pin) : (level ? 255 : 0));
+		} else {
+			simOutput(SIM_OUTPUT_DIGITAL, pin, level ? HIGH : LOW);
+		}
+	}
+}
+
+// Clock select bits to prescaler, 0 for stopped or an external clock
+static const uint16_t timer0Prescalers[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+static const uint16_t timer2Prescalers[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+
+bool simPwmWaveform(uint8_t pin, double* hz, double* duty) {
+	if (pin >= SIM_NUM_PINS || !pinMap[pin].tccr || !(*pinMap[pin].tccr & _BV(pinMap[pin].com)))
+		return false;
+
+	bool timer0 = pinMap[pin].tccr == &TCCR0A;
+	if (!timer0 && pinMap[pin].tccr != &TCCR2A)
+		return false;
+
+	uint8_t controlA = timer0 ? TCCR0A : TCCR2A;
+	uint8_t controlB = timer0 ? TCCR0B : TCCR2B;
+	uint16_t prescaler = (timer0 ? timer0Prescalers : timer2Prescalers)[controlB & 0x07];
+	// WGMn2 is bit 3 of TCCRnB on both timers
+	uint8_t mode = (controlA & (_BV(WGM01) | _BV(WGM00))) | ((controlB & _BV(WGM02)) ? 4 : 0);
+	bool fast = mode == 3;
+	if (!prescaler || (mode != 1 && !fast))
+		return false;
+
+	uint8_t compare = compareValue(pin);
+	uint16_t ticks = fast ? 256 : 510;
+	uint16_t highTicks = (compare == 255) ? ticks : fast ? compare + 1 : 2 * compare;
+
+	*hz = (double) F_CPU / ((double) prescaler * ticks);
+	*duty = (double) highTicks / ticks;
+	return true;
+}
+
+void simSetInput(uint8_t pin, uint8_t level) {
+	if (pin >= SIM_NUM_PINS)
+		return;
+
+	uint8_t previous = sim.digitalIn[pin];
+	sim.digitalIn[pin] = level ? HIGH : LOW;
+
+	const simPinMap* map = &pinMap[pin];
+	if (map->in) {
+		if (level)
+			*map->in |= _BV(map->bit);
+		else
+			*map->in &= (uint8_t) ~_BV(map->bit);
+	}
+
+	int interruptNum = digitalPinToInterrupt(pin);
+	if (interruptNum < 0 || !interruptHandlers[interruptNum] || previous == sim.digitalIn[pin])
+		return;
+
+	int mode = interruptModes[interruptNum];
+	bool edge = (mode == CHANGE) || (mode == FALLING && !level) || (mode == RISING && level);
+	if (edge) {
+		interruptHandlers[interruptNum]();
+		simSyncOutputs();
+	}
+}
+
+// ============================== ARDUINO CORE ===================================
+
+void pinMode(uint8_t pin, uint8_t mode) {
+	sim.pinCalls++;
+	if (pin >= SIM_NUM_PINS || !pinMap[pin].port)
+		return;
+
+	const simPinMap* map = &pinMap[pin];
+	if (mode == OUTPUT) {
+		*map->ddr |= _BV(map->bit);
+	} else {
+		*map->ddr &= (uint8_t) ~_BV(map->bit);
+		if (mode == INPUT_PULLUP)
+			*map->port |= _BV(map->bit);
+		else
+			*map->port &= (uint8_t) ~_BV(map->bit);
+	}
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+	sim.pinCalls++;
+	simAdvance(SIM_DIGITAL_IO_US);
+	if (pin >= SIM_NUM_PINS || !pinMap[pin].port)
+		return;
+
+	// Like the core, a digital write takes the pin off its timer
+	const simPinMap* map = &pinMap[pin];
+	if (map->tccr)
+		*map->tccr &= (uint8_t) ~_BV(map->com);
+
+	if (val)
+		*map->port |= _BV(map->bit);
+	else
+		*map->port &= (uint8_t) ~_BV(map->bit);
+
+	simSyncOutputs();
+}
+
+int digitalRead(uint8_t pin) {
+	sim.pinCalls++;
+	simAdvance(SIM_DIGITAL_IO_US);
+	return (pin < SIM_NUM_PINS) ? sim.digitalIn[pin] : LOW;
+}
+
+int analogRead(uint8_t pin) {
+	simAdvance(SIM_ANALOG_READ_US);
+	// Like the core, accept both channel numbers and A0..A7
+	if (pin < 8)
+		pin += A0;
+	return convert(pin, false);
+}
+
+void analogWrite(uint8_t pin, int val) {
+	pinMode(pin, OUTPUT);
+
+	if (pin >= SIM_NUM_PINS || val <= 0 || !pinMap[pin].tccr) {
+		digitalWrite(pin, (val < 128) ? LOW : HIGH);
+		return;
+	}
+	if (val >= 255) {
+		digitalWrite(pin, HIGH);
+		return;
+	}
+
+	simAdvance(SIM_DIGITAL_IO_US);
+	*pinMap[pin].tccr |= _BV(pinMap[pin].com);
+	setCompareValue(pin, (uint8_t) val);
+	simSyncOutputs();
+}
+
+int digitalPinToInterrupt(uint8_t pin) {
+	switch (pin) {
+		case 2: return 0;
+		case 3: return 1;
+		default: return -1;
+	}
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*handler)(void), int mode) {
+	if (interruptNum < NUM_EXTERNAL_INTERRUPTS) {
+		interruptHandlers[interruptNum] = handler;
+		interruptModes[interruptNum] = mode;
+	}
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+	if (interruptNum < NUM_EXTERNAL_INTERRUPTS)
+		interruptHandlers[interruptNum] = NULL;
+}
+
+unsigned long millis() {
+	return sim.timeUs / 1000;
+}
+
+unsigned long micros() {
+	return sim.timeUs;
+}
+
+void delay(unsigned long ms) {
+	spend((uint64_t) ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+	spend(us);
+}
+
+// ============================== SERIAL ===================================
+
+size_t HardwareSerial::write(uint8_t byte) {
+	// Block while the TX buffer is full, then queue the byte behind the ones in flight
+	uint64_t backlog = SIM_SERIAL_BUFFER * SIM_SERIAL_BYTE_US;
+	if (sim.timeModel && sim.serialBusyUntil > sim.timeUs + backlog)
+		spend(sim.serialBusyUntil - backlog - sim.timeUs);
+
+	uint64_t start = (sim.serialBusyUntil > sim.timeUs) ? sim.serialBusyUntil : sim.timeUs;
+	sim.serialBusyUntil = start + SIM_SERIAL_BYTE_US;
+
+	if (sim.onSerial)
+		sim.onSerial(byte, sim.timeUs);
+	return 1;
+}
+
+int HardwareSerial::availableForWrite() {
+	if (sim.serialBusyUntil <= sim.timeUs)
+		return SIM_SERIAL_BUFFER;
+
+	uint64_t queued = (sim.serialBusyUntil - sim.timeUs + SIM_SERIAL_BYTE_US - 1) / SIM_SERIAL_BYTE_US;
+	return (queued >= SIM_SERIAL_BUFFER) ? 0 : SIM_SERIAL_BUFFER - queued;
+}
+
+size_t HardwareSerial::print(const char* msg) {
+	size_t n = 0;
+	while (msg[n])
+		write((uint8_t) msg[n++]);
+	return n;
+}
+
+size_t HardwareSerial::println(const char* msg) {
+	return print(msg) + print("\r\n");
+}
+
+size_t HardwareSerial::print(long value) {
+	char buf[24];
+	snprintf(buf, sizeof(buf), "%ld", value);
+	return print(buf);
+}
+
+size_t HardwareSerial::println(long value) {
+	return print(value) + print("\r\n");
+}
+
+// ============================== LIBRARIES ===================================
+
+void Servo::write(int angle) {
+	// Same mapping as the library
+	if (angle < 0)
+		angle = 0;
+	if (angle > 180)
+		angle = 180;
+	writeMicroseconds(SIM_SERVO_MIN_PULSE + (long) angle * (SIM_SERVO_MAX_PULSE - SIM_SERVO_MIN_PULSE) / 180);
+}
+
+void Servo::writeMicroseconds(int us) {
+	simAdvance(SIM_SERVO_WRITE_US);
+	sim.servoWrites++;
+	if (us < SIM_SERVO_MIN_PULSE)
+		us = SIM_SERVO_MIN_PULSE;
+	if (us > SIM_SERVO_MAX_PULSE)
+		us = SIM_SERVO_MAX_PULSE;
+	simOutput(SIM_OUTPUT_SERVO, (uint8_t) pin, us);
+}
+
+int Servo::read() {
+	if (sim.servoPulseUs < 0)
+		return 0;
+	return (int) lround((sim.servoPulseUs - SIM_SERVO_MIN_PULSE) * 180.0 / (SIM_SERVO_MAX_PULSE - SIM_SERVO_MIN_PULSE));
+}
+
+NewPing::NewPing(uint8_t triggerPin, uint8_t echoPin, unsigned int maxCmDistance) {
+	(void) triggerPin;
+	(void) echoPin;
+	maxCm = maxCmDistance;
+	sim.sonarMaxCm = maxCmDistance;
+}
+
+unsigned long NewPing::ping_cm(unsigned int maxCmDistance) {
+	unsigned int limit = maxCmDistance ? maxCmDistance : maxCm;
+	unsigned int range = (sim.sonarCm > limit) ? 0 : sim.sonarCm;
+
+	// A miss costs the full echo timeout
+	sim.sonarPings++;
+	simAdvance(SIM_SONAR_TRIGGER_US + SIM_SONAR_US_PER_CM * (range ? range : limit));
+	return range;
+}
+
+long CapacitiveSensor::capacitiveSensor(uint8_t samples) {
+	simAdvance(samples * SIM_CAP_SAMPLE_US + sim.capTau / 2);
+	return sim.capTau;
+}
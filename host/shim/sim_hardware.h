@@ -0,0 +1,237 @@
+/**
+ * @file sim_hardware.h
+ *
+ * @brief Virtual hardware behind the host build of the robot firmware.
+ *
+ * The Arduino, Servo, NewPing and CapacitiveSensor shims all read their inputs from
+ * and write their outputs to the single global `sim` object. A simulated clock is
+ * advanced by the modelled cost of each hardware call, so millis()/micros() in the
+ * firmware see roughly the same timing they would on the Nano.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.1
+ */
+
+#ifndef __SIM_HARDWARE_H__
+#define __SIM_HARDWARE_H__
+
+#include <stdint.h>
+
+#define SIM_NUM_PINS 22
+
+// Modelled cost of each hardware call (us)
+#define SIM_ANALOG_READ_US 112
+#define SIM_ADC_CONVERSION_US 104
+#define SIM_DIGITAL_IO_US 4
+#define SIM_SERVO_WRITE_US 8
+#define SIM_SONAR_TRIGGER_US 24
+#define SIM_SONAR_US_PER_CM 57
+#define SIM_CAP_SAMPLE_US 20
+#define SIM_SERIAL_BYTE_US 1042
+#define SIM_SERIAL_BUFFER 64
+#define SIM_EEPROM_READ_US 1
+#define SIM_EEPROM_WRITE_US 3400
+
+#define SIM_EEPROM_SIZE 1024
+
+// Timer0 overflows, and wakes the CPU, this often (us)
+#define SIM_TIMER0_OVERFLOW_US 1024
+// The profiler's naked compare A interrupt: 7 cycles in, 15 pushes and pops, the divider
+// countdown and reti, about 95 cycles at 16 MHz (us)
+#define SIM_TIMER0_COMPA_US 6
+
+// ATmega328P RAM: .data and .bss up to SIM_HEAP_START, then the heap, and the stack down from
+// SIM_RAMEND, SIM_STACK_DEPTH deep while loop() runs
+#define SIM_RAM_START 0x100
+#define SIM_RAMEND 0x8FF
+#define SIM_HEAP_START 0x480
+#define SIM_STACK_DEPTH 192
+#define SIM_MALLOC_MARGIN 32		// avr-libc's __malloc_margin, kept clear below the stack
+
+// The watchdog oscillator times out after this << the WDP bits (us)
+#define SIM_WATCHDOG_BASE_US 16000
+
+// Servo library pulse range for 0 and 180 degrees
+#define SIM_SERVO_MIN_PULSE 544
+#define SIM_SERVO_MAX_PULSE 2400
+
+// Output channels reported to the edge callback
+#define SIM_OUTPUT_PWM 0
+#define SIM_OUTPUT_DIGITAL 1
+#define SIM_OUTPUT_SERVO 2
+
+typedef void (*simOutputCallback)(uint8_t kind, uint8_t pin, int value, uint64_t timeUs);
+typedef void (*simEventCallback)();
+typedef void (*simTickCallback)(uint64_t fromUs, uint64_t toUs);
+typedef void (*simSerialCallback)(uint8_t byte, uint64_t timeUs);
+
+/*
+ * @brief State of the virtual robot hardware
+ */
+struct SimHardware {
+	uint64_t timeUs;			// simulated clock
+	bool timeModel;				// advance the clock on hardware calls
+
+	uint16_t analog[SIM_NUM_PINS];		// raw ADC counts presented on each pin
+	float adcNoise;				// std-dev (counts) of the noise on every conversion
+	float adcCpuNoise;			// more of it when the CPU runs during the conversion
+	uint8_t digitalIn[SIM_NUM_PINS];	// levels presented on each input pin, set with simSetInput()
+	uint16_t sonarCm;			// range returned by the next ping (0 = nothing in range)
+	uint16_t sonarMaxCm;			// max range the sketch configured
+	long capTau;				// tau returned by the next capacitive sample
+
+	int pwm[SIM_NUM_PINS];			// last duty seen on each PWM-capable output pin
+	uint8_t digitalOut[SIM_NUM_PINS];	// last level seen on each other output pin
+	int servoPulseUs;			// last pulse width written to the servo, -1 before the first
+	uint32_t servoWrites;			// number of servo writes, including ones that changed nothing
+	uint64_t serialBusyUntil;		// time the TX buffer drains completely
+	simSerialCallback onSerial;		// called with every byte written to Serial
+
+	uint64_t sleepUs;			// time spent asleep in sleep_cpu()
+	uint8_t sleepMode;			// last set_sleep_mode()
+	uint64_t adcDoneUs;			// when the conversion started with ADSC finishes, 0 if none
+	uint32_t sonarPings;			// number of sonar pings sent
+	uint32_t pinCalls;			// number of pinMode/digitalWrite/digitalRead calls, analogWrite makes its own
+
+	simOutputCallback onOutput;		// called whenever an output changes value
+
+	uint64_t eventAtUs;			// time the pending event fires
+	simEventCallback onEvent;		// pending event, cleared once it fires
+
+	simTickCallback onTick;			// called whenever the clock advances, used by world models
+
+	uint16_t interruptedPc;			// where the clock was when a timer interrupt fired, see profiler.h
+	uint8_t ocr0a;				// the OCR0A the compare unit is using, see runTimer0Compares()
+	uint64_t timer0Overflow;		// the Timer0 overflow it was loaded in
+
+	uint8_t ram[SIM_RAMEND + 1 - SIM_RAM_START];	// SRAM, from SIM_RAM_START
+	uint16_t heapBreak;			// avr-libc's __brkval, 0 until the first simMalloc()
+	uint32_t mallocs;			// simMalloc() calls that succeeded
+	uint32_t mallocFailures;		// and that ran into the stack
+
+	uint64_t watchdogKickUs;		// last wdt_reset(), or wdt_enable()
+	uint32_t watchdogResets;		// number of watchdog timeouts that reset the chip
+	simEventCallback onWatchdogReset;	// called on each of them, doesn't need to return
+};
+
+extern SimHardware sim;
+
+// EEPROM contents and how often each cell was written. Like the real thing they survive
+// simReset(), and start out erased.
+extern uint8_t simEeprom[SIM_EEPROM_SIZE];
+extern uint32_t simEepromWrites[SIM_EEPROM_SIZE];
+
+/**
+ * @brief	Erases the EEPROM back to 0xFF and clears the write counts.
+ */
+void simEraseEeprom();
+
+/**
+ * @brief	Resets the virtual hardware to power-on state.
+ *
+ * SP is set SIM_STACK_DEPTH below SIM_RAMEND, and the RAM is cleared and then handed to the
+ * sketch's simInit1(), if it has one, the way the AVR runs .init1 before main().
+ */
+void simReset();
+
+/**
+ * @brief	Returns where an address in the ATmega328P's RAM lives in sim.ram.
+ */
+uint8_t* simRamAt(uint16_t address);
+
+/**
+ * @brief	Allocates from the heap in sim.ram the way avr-libc's malloc() does.
+ *
+ * Each chunk is its two byte size and then the data, put at __brkval, which moves up past it.
+ * Fails within SIM_MALLOC_MARGIN of the stack pointer.
+ *
+ * @return The data, NULL if there's no room
+ */
+void* simMalloc(uint16_t size);
+
+/**
+ * @brief	Frees a chunk from simMalloc().
+ *
+ * Like avr-libc, freeing the chunk at the top of the heap lowers __brkval to its start and
+ * leaves its bytes as they were. Chunks below it aren't reused, the model only needs the
+ * malloc() and free() in turn the telemetry frames make.
+ */
+void simFree(void* ptr);
+
+/**
+ * @brief	Advances the simulated clock.
+ *
+ * Timer interrupts the sketch enabled fire on the way, with interruptedPc set to the word
+ * offset, from the start of the image, of the hardware call that spent the time. Each Timer0
+ * compare A interrupt takes SIM_TIMER0_COMPA_US, and the call ends that much later.
+ *
+ * So does the watchdog, if it's been SIM_WATCHDOG_BASE_US << WDP since watchdogKickUs. With WDIE
+ * set that runs WDT_vect, clearing WDIE if WDE is set, and with only WDE set it resets: WDTCSR is
+ * cleared, WDRF set in MCUSR and onWatchdogReset called. Nothing else is reset, that's left to
+ * the callback.
+ *
+ * @param us The number of microseconds to advance
+ */
+void simAdvance(uint32_t us);
+
+/**
+ * @brief	Schedules a one-shot event for when the simulated clock reaches atUs.
+ *
+ * The event fires in the middle of whatever hardware call carries the clock past atUs,
+ * so inputs changed by it are seen by every read that completes afterwards.
+ */
+void simSchedule(uint64_t atUs, simEventCallback event);
+
+/**
+ * @brief	Sleeps until the next interrupt: the next Timer0 overflow, the pending event, or the
+ * 			end of the ADC conversion started with ADSC. In SLEEP_MODE_ADC Timer0 is stopped
+ * 			and doesn't wake it.
+ *
+ * A conversion finishing sets ADC, clears ADSC and runs ADC_vect when ADIE is set. One that
+ * ran in SLEEP_MODE_ADC only has adcNoise on it, otherwise adcCpuNoise is added.
+ */
+void simSleep();
+
+/**
+ * @brief	Reports an output write, calling the edge callback if its value changed.
+ */
+void simOutput(uint8_t kind, uint8_t pin, int value);
+
+/**
+ * @brief	Presents a level on a digital input pin.
+ *
+ * Updates the PINx register and runs the handler attached with attachInterrupt() when
+ * the change matches its edge.
+ */
+void simSetInput(uint8_t pin, uint8_t level);
+
+/**
+ * @brief	Derives every output pin from the port and timer registers and reports changes.
+ *
+ * Pins with their timer compare output enabled report the OCR duty, every other
+ * output pin reports its PORTx bit.
+ */
+void simSyncOutputs();
+
+/**
+ * @brief	Works out a PWM pin's output waveform from its timer registers.
+ *
+ * Follows the Timer0/Timer2 waveform generator in the two modes that count to 255: fast PWM is
+ * high from BOTTOM up to the compare match, OCR + 1 of 256 ticks, and phase correct is high
+ * while the count is below the compare value on the way up and back down, 2 x OCR of 510.
+ * An OCR of 255 holds the pin high in both. The clock is F_CPU over the prescaler the clock
+ * select bits pick.
+ *
+ * @param uint8_t pin : the pin
+ * @param double* hz : set to the PWM frequency
+ * @param double* duty : set to the share of the period the pin is high
+ *
+ * @return false if the pin isn't on a running Timer0/Timer2 channel, in one of those modes,
+ * 		with its compare output on
+ */
+bool simPwmWaveform(uint8_t pin, double* hz, double* duty);
+
+#endif  // __SIM_HARDWARE_H__
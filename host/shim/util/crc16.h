@@ -0,0 +1,27 @@
+/**
+ * @file crc16.h
+ *
+ * @brief Host stand-in for util/crc16.h
+ *
+ * The C equivalent avr-libc documents for its inline assembly.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __HOST_UTIL_CRC16_H__
+#define __HOST_UTIL_CRC16_H__
+
+#include <stdint.h>
+
+static inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data) {
+	data ^= (uint8_t) crc;
+	data ^= data << 4;
+
+	return (((uint16_t) data << 8) | (crc >> 8)) ^ (uint8_t) (data >> 4) ^ ((uint16_t) data << 3);
+}
+
+#endif  // __HOST_UTIL_CRC16_H__
@@ -0,0 +1,150 @@
+/**
+ * @file tracking_bench.cpp
+ *
+ * @brief Steady state tracking error against a light moving at constant speed.
+ *
+ * Scenarios, each run for RUN_S simulated seconds after WARMUP_S to lock on:
+ *
+ *     orbit      the light circles the driving robot at ORBIT_RADIUS_CM and ORBIT_DPS, like
+ *                someone walking round it, and the bearing error is measured
+ *     elevation  the robot is stopped and the light goes up and down at ELEVATION_CMPS in front
+ *                of it, and the elevation error of the array is measured
+ *     dropout    the orbit, with the light switched off for DROPOUT_MS every DROPOUT_PERIOD_MS
+ *
+ * Reports the mean and 90th percentile absolute error, and the share of the time the light
+ * flags were set.
+ *
+ * Built twice by `make tracking`: once as is, and once with LIGHT_NO_TRACKER defined.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+#include "includes.h"
+#include "world.h"
+
+#define WARMUP_S 5
+#define RUN_S 60
+#define SAMPLE_US 10000
+
+#define ORBIT_RADIUS_CM 200
+#define ORBIT_DPS 20.0
+#define ORBIT_HEIGHT_CM 30
+
+#define ELEVATION_RANGE_CM 250
+#define ELEVATION_LOW_CM -60
+#define ELEVATION_HIGH_CM 120
+#define ELEVATION_CMPS 40.0
+
+#define DROPOUT_MS 250
+#define DROPOUT_PERIOD_MS 2000
+
+#define CAP_UNTOUCHED 50
+
+extern ROBOT_SPEED robotSpeed;
+extern detectionDataStruct detectedData;
+extern actionStateStruct actionStates;
+
+enum scenarioType {SCENARIO_ORBIT, SCENARIO_ELEVATION, SCENARIO_DROPOUT, NUM_SCENARIOS};
+
+static const char* scenarioNames[NUM_SCENARIOS] = {"orbit", "elevation", "dropout"};
+
+static scenarioType scenario;
+static uint64_t startUs;
+
+// Moves the light along its path, relative to wherever the robot has got to
+static void trackingTick(uint64_t fromUs, uint64_t toUs) {
+	double t = (toUs - startUs) / 1e6;
+
+	if (scenario == SCENARIO_ELEVATION) {
+		// Triangle wave between the low and high points
+		double span = ELEVATION_HIGH_CM - ELEVATION_LOW_CM;
+		double travelled = fmod(t * ELEVATION_CMPS, 2 * span);
+		world.light.z = ELEVATION_LOW_CM + ((travelled < span) ? travelled : 2 * span - travelled);
+	} else {
+		double angle = ORBIT_DPS * t * M_PI / 180.0;
+		world.light.x = world.robot.x + ORBIT_RADIUS_CM * cos(angle);
+		world.light.y = world.robot.y + ORBIT_RADIUS_CM * sin(angle);
+		world.light.on = scenario != SCENARIO_DROPOUT
+				|| (uint64_t) (t * 1000) % DROPOUT_PERIOD_MS >= DROPOUT_MS;
+	}
+
+	worldTick(fromUs, toUs);
+}
+
+static bool lightDetected() {
+	return detectedData.lightDetected.left || detectedData.lightDetected.right
+			|| detectedData.lightDetected.up || detectedData.lightDetected.down;
+}
+
+static void runScenario(scenarioType type) {
+	simReset();
+	worldReset();
+	sim.onTick = trackingTick;
+	sim.capTau = CAP_UNTOUCHED;
+	scenario = type;
+	startUs = sim.timeUs;
+
+	if (type == SCENARIO_ELEVATION) {
+		world.light = {ELEVATION_RANGE_CM, 0, ELEVATION_LOW_CM, 0, 0, true};
+		robotSpeed = STOPPED;
+	} else {
+		world.light = {ORBIT_RADIUS_CM, 0, ORBIT_HEIGHT_CM, 0, 0, true};
+		robotSpeed = SLOW;
+	}
+
+	detectedData = NEW_DETECTION_DATA_STRUCT;
+	actionStates = NEW_ACTION_STATE_STRUCT;
+	initPins();
+	initServo();
+	// Start pointing at the light
+	world.robot.tilt = WORLD_SERVO_LEVEL_ANGLE;
+	initServoPlanner(WORLD_SERVO_LEVEL_ANGLE);
+
+	std::vector<double> errors;
+	uint64_t seenSamples = 0;
+	uint64_t nextSampleUs = startUs + WARMUP_S * 1000000ULL;
+	uint64_t endUs = nextSampleUs + RUN_S * 1000000ULL;
+
+	while (sim.timeUs < endUs) {
+		RobotDetection();
+		RobotPlanning();
+		RobotAction();
+
+		while (sim.timeUs >= nextSampleUs && nextSampleUs < endUs) {
+			double error = (type == SCENARIO_ELEVATION) ? worldLightElevationError() : worldLightBearing();
+			errors.push_back(fabs(error));
+			seenSamples += lightDetected();
+			nextSampleUs += SAMPLE_US;
+		}
+	}
+
+	double sum = 0;
+	for (double error : errors)
+		sum += error;
+	std::sort(errors.begin(), errors.end());
+
+	printf("%-10s %10.1f %10.1f %9.0f\n", scenarioNames[type], sum / errors.size(),
+			errors[errors.size() * 9 / 10], 100.0 * seenSamples / errors.size());
+}
+
+int main() {
+#ifdef LIGHT_NO_TRACKER
+	printf("Light tracker: off\n");
+#else
+	printf("Light tracker: lead %d ms plus the loop period, coast %d ms\n",
+			TRACKER_ACTUATOR_LAG_MS, TRACKER_COAST_MS);
+#endif
+
+	printf("%-10s %10s %10s %9s\n", "scenario", "mean deg", "p90 deg", "seen %");
+	for (int type = 0; type < NUM_SCENARIOS; type++)
+		runScenario((scenarioType) type);
+	return 0;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file world.cpp
+ *
+ * @brief Implementation of the world model defined in world.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "world.h"
+#include "includes.h"
+
+#define STEP_US 1000
+#define DEG (M_PI / 180.0)
+
+World world;
+
+static double wrapAngle(double a) {
+	while (a > M_PI)
+		a -= 2 * M_PI;
+	while (a < -M_PI)
+		a += 2 * M_PI;
+	return a;
+}
+
+void worldReset() {
+	memset(&world, 0, sizeof(world));
+	world.robot.tilt = SERVO_ANGLE_START;
+	world.robot.batteryVolts = WORLD_NOMINAL_VOLTS;
+	world.robot.supplyVolts = WORLD_NOMINAL_VOLTS;
+	world.robot.rightGain = 1.0;
+	world.drivePhotodiodes = true;
+	world.driveSonar = true;
+
+	sim.onTick = worldTick;
+}
+
+worldObstacle* worldAddObstacle(double x, double y, double radius, double vx, double vy) {
+	if (world.numObstacles >= WORLD_MAX_OBSTACLES)
+		return NULL;
+
+	worldObstacle* obstacle = &world.obstacles[world.numObstacles++];
+	*obstacle = {x, y, radius, vx, vy, true, false};
+	return obstacle;
+}
+
+static double wheelTarget(int pwm) {
+	if (pwm <= WORLD_PWM_DEADBAND)
+		return 0;
+	double duty = (double) (pwm - WORLD_PWM_DEADBAND) / (255 - WORLD_PWM_DEADBAND);
+	return WORLD_WHEEL_MAX_CMPS * duty * world.robot.supplyVolts / WORLD_NOMINAL_VOLTS;
+}
+
+/*
+ * Current through one motor at the given supply: whatever the back EMF at the wheel's speed
+ * doesn't cancel out. Friction and the deadband show up as the gap between wheelTarget() and
+ * the no-load speed.
+ */
+static double motorAmps(int pwm, double speed, double supplyVolts) {
+	double noLoadSpeed = WORLD_WHEEL_MAX_CMPS * (pwm / 255.0) * supplyVolts / WORLD_NOMINAL_VOLTS;
+	double amps = WORLD_MOTOR_STALL_A * (noLoadSpeed - speed) / WORLD_WHEEL_MAX_CMPS;
+	return (amps > 0) ? amps : 0;
+}
+
+static double totalMotorAmps(double supplyVolts) {
+	worldRobot* robot = &world.robot;
+	return motorAmps(sim.pwm[MOTOR_LEFT], robot->vLeft, supplyVolts)
+			+ motorAmps(sim.pwm[MOTOR_RIGHT], robot->vRight / robot->rightGain, supplyVolts);
+}
+
+/*
+ * The motor current sags the supply it is drawn from. Rather than use the last step's supply,
+ * which lets both wheels starting at once see no sag at all, bisect for the voltage where the
+ * two agree. The sag only grows with the supply, so there is exactly one.
+ */
+static void updateSupply() {
+	worldRobot* robot = &world.robot;
+	double low = 0;
+	double high = robot->batteryVolts;
+
+	for (int i = 0; i < 20; i++) {
+		double volts = (low + high) / 2;
+		if (robot->batteryVolts - totalMotorAmps(volts) * WORLD_BATTERY_OHMS < volts)
+			high = volts;
+		else
+			low = volts;
+	}
+
+	robot->supplyVolts = (low + high) / 2;
+	robot->motorAmps = totalMotorAmps(robot->supplyVolts);
+}
+
+double worldSpeed() {
+	return (world.robot.vLeft + world.robot.vRight) / 2;
+}
+
+double worldLightBearing() {
+	double toLight = atan2(world.light.y - world.robot.y, world.light.x - world.robot.x);
+	return wrapAngle(toLight - world.robot.heading) / DEG;
+}
+
+double worldLightElevationError() {
+	double range = hypot(world.light.x - world.robot.x, world.light.y - world.robot.y);
+	double lightElevation = atan2(world.light.z, range) / DEG;
+	return lightElevation - (world.robot.tilt - WORLD_SERVO_LEVEL_ANGLE);
+}
+
+/*
+ * Distance from the front of the robot to the obstacle surface along the heading,
+ * and the obstacle's offset from the robot's centre line.
+ */
+static void obstacleGeometry(const worldObstacle* obstacle, double* ahead, double* lateral) {
+	double dx = obstacle->x - world.robot.x;
+	double dy = obstacle->y - world.robot.y;
+	double c = cos(world.robot.heading);
+	double s = sin(world.robot.heading);
+
+	*ahead = dx * c + dy * s - obstacle->radius - WORLD_HALF_WIDTH_CM;
+	*lateral = -dx * s + dy * c;
+}
+
+static void updateSonar() {
+	double nearest = 0;
+
+	for (int i = 0; i < world.numObstacles; i++) {
+		const worldObstacle* obstacle = &world.obstacles[i];
+		if (!obstacle->active)
+			continue;
+
+		double ahead, lateral;
+		obstacleGeometry(obstacle, &ahead, &lateral);
+		if (ahead < 0)
+			ahead = 0;
+
+		// Inside the beam if any part of it is inside the cone
+		double beam = (ahead + WORLD_HALF_WIDTH_CM) * tan(WORLD_SONAR_HALF_ANGLE_DEG * DEG);
+		if (fabs(lateral) > beam + obstacle->radius)
+			continue;
+
+		if (nearest == 0 || ahead < nearest)
+			nearest = ahead;
+	}
+
+	if (nearest == 0 || nearest > ULTRASONIC_MAX_DIST) {
+		sim.sonarCm = 0;
+	} else {
+		// NewPing rounds down and reports 0 for anything closer than 1 cm
+		sim.sonarCm = (uint16_t) nearest;
+	}
+}
+
+static uint16_t diodeCounts(double azimuthOffset, double elevationOffset) {
+	double dx = world.light.x - world.robot.x;
+	double dy = world.light.y - world.robot.y;
+	double dz = world.light.z;
+	double range = sqrt(dx * dx + dy * dy + dz * dz);
+
+	double voltage = WORLD_AMBIENT_V;
+	if (world.light.on && range > 0) {
+		double az = world.robot.heading + azimuthOffset * DEG;
+		double el = (world.robot.tilt - WORLD_SERVO_LEVEL_ANGLE + elevationOffset) * DEG;
+		double axis[3] = {cos(el) * cos(az), cos(el) * sin(az), sin(el)};
+
+		double cosAngle = (axis[0] * dx + axis[1] * dy + axis[2] * dz) / range;
+		if (cosAngle > 1)
+			cosAngle = 1;
+		double angle = acos(cosAngle) / DEG / WORLD_DIODE_LOBE_DEG;
+
+		voltage += WORLD_DIODE_GAIN_V * exp(-angle * angle) * WORLD_DIODE_REF_CM / range;
+	}
+
+	if (voltage > WORLD_DIODE_MAX_V)
+		voltage = WORLD_DIODE_MAX_V;
+	return (uint16_t) (voltage / VOLTAGE_MAX * SENSOR_MAX_OUT);
+}
+
+static void updateBattery() {
+	double counts = world.robot.supplyVolts / BATTERY_DIVIDER_RATIO / VOLTAGE_MAX * SENSOR_MAX_OUT;
+	sim.analog[BATTERY_PIN] = (counts > SENSOR_MAX_OUT - 1) ? SENSOR_MAX_OUT - 1 : (uint16_t) counts;
+}
+
+static void updatePhotodiodes() {
+	sim.analog[PHOTODIODE_TOP_LEFT] = diodeCounts(WORLD_DIODE_SPLIT_DEG, WORLD_DIODE_SPLIT_DEG);
+	sim.analog[PHOTODIODE_BOTTOM_LEFT] = diodeCounts(WORLD_DIODE_SPLIT_DEG, -WORLD_DIODE_SPLIT_DEG);
+	sim.analog[PHOTODIODE_BOTTOM_RIGHT] = diodeCounts(-WORLD_DIODE_SPLIT_DEG, -WORLD_DIODE_SPLIT_DEG);
+	sim.analog[PHOTODIODE_TOP_RIGHT] = diodeCounts(-WORLD_DIODE_SPLIT_DEG, WORLD_DIODE_SPLIT_DEG);
+}
+
+static void step(double dt) {
+	worldRobot* robot = &world.robot;
+
+	// Wheels follow their PWM with a first order lag
+	double alpha = dt / (WORLD_MOTOR_TAU_S + dt);
+	robot->vLeft += (wheelTarget(sim.pwm[MOTOR_LEFT]) - robot->vLeft) * alpha;
+	robot->vRight += (wheelTarget(sim.pwm[MOTOR_RIGHT]) * robot->rightGain - robot->vRight) * alpha;
+
+	// The battery sags under the motor current
+	updateSupply();
+
+	// Servo slews towards the last commanded angle
+	if (sim.servoPulseUs >= 0) {
+		double commanded = (sim.servoPulseUs - SIM_SERVO_MIN_PULSE) * 180.0 / (SIM_SERVO_MAX_PULSE - SIM_SERVO_MIN_PULSE);
+		double error = commanded - robot->tilt;
+		double maxStep = WORLD_SERVO_SLEW_DPS * dt;
+		robot->tilt += (error > maxStep) ? maxStep : (error < -maxStep) ? -maxStep : error;
+	}
+
+	for (int i = 0; i < world.numObstacles; i++) {
+		world.obstacles[i].x += world.obstacles[i].vx * dt;
+		world.obstacles[i].y += world.obstacles[i].vy * dt;
+	}
+	world.light.x += world.light.vx * dt;
+	world.light.y += world.light.vy * dt;
+
+	double v = worldSpeed();
+	double omega = (robot->vRight - robot->vLeft) / WORLD_WHEEL_BASE_CM;
+	double newX = robot->x + v * cos(robot->heading) * dt;
+	double newY = robot->y + v * sin(robot->heading) * dt;
+
+	// An obstacle in the robot's lane stops it dead, and counts as an impact the first time
+	world.blocked = false;
+	for (int i = 0; i < world.numObstacles; i++) {
+		worldObstacle* obstacle = &world.obstacles[i];
+		if (!obstacle->active)
+			continue;
+
+		double ahead, lateral;
+		obstacleGeometry(obstacle, &ahead, &lateral);
+		bool inLane = fabs(lateral) < obstacle->radius + WORLD_HALF_WIDTH_CM;
+		if (inLane && ahead <= 0 && ahead > -obstacle->radius && v > 0) {
+			world.blocked = true;
+			if (!obstacle->hit) {
+				obstacle->hit = true;
+				world.impacts++;
+			}
+		}
+	}
+
+	if (world.blocked) {
+		robot->vLeft = robot->vRight = 0;
+	} else {
+		world.distanceCm += fabs(v) * dt;
+		robot->x = newX;
+		robot->y = newY;
+	}
+	robot->heading = wrapAngle(robot->heading + omega * dt);
+}
+
+void worldTick(uint64_t fromUs, uint64_t toUs) {
+	for (uint64_t t = fromUs; t < toUs; t += STEP_US) {
+		uint64_t span = (toUs - t < STEP_US) ? toUs - t : STEP_US;
+		step(span / 1e6);
+	}
+
+	updateBattery();
+	if (world.driveSonar)
+		updateSonar();
+	if (world.drivePhotodiodes)
+		updatePhotodiodes();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file world.h
+ *
+ * @brief Physical model of the robot and its surroundings for the host simulations.
+ *
+ * The world is integrated every time the simulated clock advances. It reads the motor
+ * PWM and servo angle the firmware has written to the virtual hardware, moves the robot,
+ * and writes the resulting photodiode voltages and sonar range back as sensor inputs.
+ *
+ * Conventions: positions in cm, heading in radians counter-clockwise from +x, so the left
+ * wheel is on the +y side. Elevation in degrees, positive up.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __WORLD_H__
+#define __WORLD_H__
+
+#include <stdint.h>
+
+#define WORLD_MAX_OBSTACLES 64
+
+// Drive train
+#define WORLD_WHEEL_BASE_CM 12.0
+#define WORLD_HALF_WIDTH_CM 7.5
+#define WORLD_WHEEL_MAX_CMPS 60.0	// wheel speed at full PWM on a fresh battery
+#define WORLD_PWM_DEADBAND 40		// PWM below which the wheels don't turn
+#define WORLD_MOTOR_TAU_S 0.15		// time constant of the wheel speed
+#define WORLD_NOMINAL_VOLTS 9.0
+#define WORLD_MOTOR_STALL_A 1.5		// current of one motor held still at full PWM
+#define WORLD_BATTERY_OHMS 1.5		// internal resistance of the battery
+
+// Servo and photodiode head
+#define WORLD_SERVO_LEVEL_ANGLE 135	// servo angle at which the array looks level
+#define WORLD_SERVO_SLEW_DPS 400.0
+#define WORLD_DIODE_SPLIT_DEG 15.0	// angle between the array axis and each diode
+#define WORLD_DIODE_LOBE_DEG 45.0	// width of each diode's response lobe
+#define WORLD_DIODE_GAIN_V 5.0		// on-axis voltage at the reference distance
+#define WORLD_DIODE_REF_CM 200.0
+#define WORLD_AMBIENT_V 0.3
+#define WORLD_DIODE_MAX_V 5.0
+
+// Sonar
+#define WORLD_SONAR_HALF_ANGLE_DEG 15.0
+
+/*
+ * @brief Pose and drive state of the robot
+ */
+struct worldRobot {
+	double x;
+	double y;
+	double heading;
+	double vLeft;		// wheel speeds (cm/s)
+	double vRight;
+	double tilt;		// physical servo angle (deg)
+	double batteryVolts;	// open circuit voltage
+	double supplyVolts;	// voltage at the motors, after the sag from the motor current
+	double motorAmps;	// current drawn by both motors
+	double rightGain;	// right wheel speed relative to the left one at the same PWM
+};
+
+/*
+ * @brief A round obstacle, optionally moving
+ */
+struct worldObstacle {
+	double x;
+	double y;
+	double radius;
+	double vx;
+	double vy;
+	bool active;
+	bool hit;		// set once the robot has run into it
+};
+
+/*
+ * @brief A point light source
+ */
+struct worldLight {
+	double x;
+	double y;
+	double z;		// height above the photodiode array
+	double vx;
+	double vy;
+	bool on;
+};
+
+/*
+ * @brief Everything the simulations move around
+ */
+struct World {
+	worldRobot robot;
+	worldLight light;
+	worldObstacle obstacles[WORLD_MAX_OBSTACLES];
+	int numObstacles;
+
+	bool drivePhotodiodes;	// write photodiode inputs from the light model
+	bool driveSonar;	// write the sonar range from the obstacles
+	bool blocked;		// robot is pressed against an obstacle
+
+	uint32_t impacts;
+	double distanceCm;	// distance driven
+};
+
+extern World world;
+
+/**
+ * @brief	Resets the world and hooks it into the simulated clock.
+ *
+ * The robot starts at the origin facing +x with the servo at SERVO_ANGLE_START.
+ */
+void worldReset();
+
+/**
+ * @brief	Integrates the world over the given span of simulated time.
+ */
+void worldTick(uint64_t fromUs, uint64_t toUs);
+
+/**
+ * @brief	Adds an obstacle and returns it.
+ */
+worldObstacle* worldAddObstacle(double x, double y, double radius, double vx, double vy);
+
+/**
+ * @brief	Angle of the light relative to the robot's heading (deg, positive to the left).
+ */
+double worldLightBearing();
+
+/**
+ * @brief	Angle of the light relative to the array's elevation (deg, positive up).
+ */
+double worldLightElevationError();
+
+/**
+ * @brief	Forward speed of the robot (cm/s).
+ */
+double worldSpeed();
+
+#endif  // __WORLD_H__
@@ -0,0 +1,71 @@
+/**
+ * @file battery.h
+ *
+ * @brief Battery monitor and speed governor.
+ *
+ * The battery is read through a divider on BATTERY_PIN every BATTERY_SAMPLE_INTERVAL and
+ * low-pass filtered, so the sag from the motors starting up doesn't show up as a flat
+ * battery. The motor PWM is scaled by BATTERY_NOMINAL_VOLTS over the filtered voltage, so a
+ * given ROBOT_SPEED drives the wheels at the same speed over the whole discharge curve.
+ *
+ * The remaining charge comes from the discharge curve in battery_table.h, which is generated
+ * from measured discharge logs, and is turned into a runtime at BATTERY_AVERAGE_MA.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __BATTERY_H__
+#define __BATTERY_H__
+
+#include "includes.h"
+#include "battery_table.h"
+
+// Power modes
+#define POWER_NORMAL	0
+#define POWER_REDUCED	1
+
+/**
+ * @brief	Samples and filters the battery voltage, at most every BATTERY_SAMPLE_INTERVAL.
+ *
+ * Samples every call, and takes the reading as is, until a battery is seen on the divider.
+ * Updates the global batteryVoltage.
+ */
+void readBatteryVoltage();
+
+/**
+ * @brief	Looks up the state of charge on the discharge curve.
+ *
+ * @param float volts : the battery voltage
+ *
+ * @return uint8_t : the charge left (percent)
+ */
+uint8_t batteryStateOfCharge(float volts);
+
+/**
+ * @brief	Looks up the charge left in the battery.
+ *
+ * @param float volts : the battery voltage
+ *
+ * @return uint16_t : the charge left (mAh)
+ */
+uint16_t batteryChargeLeft(float volts);
+
+/**
+ * @brief	Estimates how long the robot can keep running before the battery is dead.
+ *
+ * @return uint16_t : minutes until batteryVoltage reaches BATTERY_DEAD_VOLTS at BATTERY_AVERAGE_MA
+ */
+uint16_t batteryRuntimeMinutes();
+
+/**
+ * @brief	Works out how much to scale the motor PWM by for the current battery voltage.
+ *
+ * @return uint16_t : the scale, 256 being 1
+ */
+uint16_t batteryCompensation();
+
+#endif  // __BATTERY_H__
@@ -0,0 +1,38 @@
+/**
+ * @file battery_table.h
+ *
+ * @brief Discharge curve and charge thresholds for 9V batteries.
+ *
+ * Generated by src/batteryDataAnalyis.py, run `make battery-table` rather than editing it. Fitted
+ * to the following logs across a 200 ohm load, 39 mV RMS from the measurements:
+ *     data/9V_battery_sheet.csv
+ *
+ * batteryCurve holds the battery voltage (mV) at every BATTERY_CURVE_STEP percent state of charge,
+ * from empty to full.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ */
+
+#ifndef __BATTERY_TABLE_H__
+#define __BATTERY_TABLE_H__
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define BATTERY_CAPACITY_MAH 609
+
+#define BATTERY_HIGH_VOLTS 8.05	// 85% charge left
+#define BATTERY_MED_VOLTS 7.15	// 40% charge left
+#define BATTERY_REDUCED_VOLTS 6.60	// 20% charge left
+#define BATTERY_DEAD_VOLTS 6.37	// 15% charge left
+
+#define BATTERY_CURVE_STEP 5
+#define BATTERY_CURVE_POINTS 21
+
+static const uint16_t batteryCurve[BATTERY_CURVE_POINTS] PROGMEM = {
+	5041, 5636, 6063, 6371, 6598, 6772, 6915,
+	7038, 7151, 7256, 7356, 7449, 7536, 7618,
+	7699, 7788, 7899, 8054, 8282, 8622, 9126,
+};
+
+#endif  // __BATTERY_TABLE_H__
@@ -0,0 +1,255 @@
+/**
+ * @file board.h
+ *
+ * @brief Compile-time description of the Arduino Nano pins, and direct port I/O on top of it.
+ *
+ * digitalWrite()/pinMode()/analogWrite() look the pin's port, bit and timer up in flash tables
+ * on every call, and check for PWM, before they touch a register. Here the same mapping is a
+ * constexpr table, and the pin is a template parameter, so each write comes down to the register
+ * access itself: pinHigh() and pinLow() set or clear the pin's bit in its PORTx, and pwmWrite()
+ * stores to the pin's OCRnx. How many cycles either way takes hasn't been measured on the AVR.
+ *
+ * Every pin in params.h is checked against the table when the sketch is compiled: no pin is
+ * used twice, PWM outputs sit on a timer channel, and nothing else needs Timer1 while the
+ * servo has it.
+ *
+ * Define BOARD_ARDUINO_IO to go back through the Arduino calls, e.g. to compare the two.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+#include <stdint.h>
+#include <Arduino.h>
+#include <avr/io.h>
+
+#include "params.h"
+
+#define BOARD_NUM_PINS 22
+
+enum BOARD_PORT {BOARD_PORT_NONE, BOARD_PORT_B, BOARD_PORT_C, BOARD_PORT_D};
+enum BOARD_TIMER {BOARD_TIMER_NONE, BOARD_TIMER_0A, BOARD_TIMER_0B, BOARD_TIMER_1A, BOARD_TIMER_1B,
+		BOARD_TIMER_2A, BOARD_TIMER_2B};
+
+/*
+ * @brief Where a Nano pin lives in the port and timer registers
+ */
+typedef struct _boardPinStruct {
+	uint8_t port;
+	uint8_t bit;
+	uint8_t timer;		// timer channel driving the pin's PWM
+} boardPinStruct;
+
+// Indexed by Arduino pin number, D0 to D13 then A0 to A7
+static constexpr boardPinStruct boardPins[BOARD_NUM_PINS] = {
+	{BOARD_PORT_D, 0, BOARD_TIMER_NONE},
+	{BOARD_PORT_D, 1, BOARD_TIMER_NONE},
+	{BOARD_PORT_D, 2, BOARD_TIMER_NONE},
+	{BOARD_PORT_D, 3, BOARD_TIMER_2B},
+	{BOARD_PORT_D, 4, BOARD_TIMER_NONE},
+	{BOARD_PORT_D, 5, BOARD_TIMER_0B},
+	{BOARD_PORT_D, 6, BOARD_TIMER_0A},
+	{BOARD_PORT_D, 7, BOARD_TIMER_NONE},
+	{BOARD_PORT_B, 0, BOARD_TIMER_NONE},
+	{BOARD_PORT_B, 1, BOARD_TIMER_1A},
+	{BOARD_PORT_B, 2, BOARD_TIMER_1B},
+	{BOARD_PORT_B, 3, BOARD_TIMER_2A},
+	{BOARD_PORT_B, 4, BOARD_TIMER_NONE},
+	{BOARD_PORT_B, 5, BOARD_TIMER_NONE},
+	{BOARD_PORT_C, 0, BOARD_TIMER_NONE},
+	{BOARD_PORT_C, 1, BOARD_TIMER_NONE},
+	{BOARD_PORT_C, 2, BOARD_TIMER_NONE},
+	{BOARD_PORT_C, 3, BOARD_TIMER_NONE},
+	{BOARD_PORT_C, 4, BOARD_TIMER_NONE},
+	{BOARD_PORT_C, 5, BOARD_TIMER_NONE},
+	{BOARD_PORT_NONE, 0, BOARD_TIMER_NONE},		// A6 and A7 are analog only
+	{BOARD_PORT_NONE, 0, BOARD_TIMER_NONE},
+};
+
+// ============================= COMPILE-TIME PIN CHECKS =====================================
+
+// Every pin the robot uses, see params.h
+static constexpr uint8_t boardUsedPins[] = {
+	BUTTON_COLLISION, BUMPER_PIN, LED_COLLISION, LED_BUILTIN, MOTOR_LEFT, MOTOR_RIGHT,
+	BATTERY_PIN, PHOTODIODE_TOP_LEFT, PHOTODIODE_BOTTOM_LEFT, PHOTODIODE_BOTTOM_RIGHT,
+	PHOTODIODE_TOP_RIGHT, ULTRASONIC_TRIGGER_PIN, ULTRASONIC_ECHO_PIN, SERVO_PIN,
+	CAP_OUT_PIN, CAP_IN_PIN,
+};
+
+#define BOARD_NUM_USED_PINS (sizeof(boardUsedPins) / sizeof(boardUsedPins[0]))
+
+constexpr bool boardPinUsedFrom(uint8_t pin, unsigned int i) {
+	return i < BOARD_NUM_USED_PINS && (boardUsedPins[i] == pin || boardPinUsedFrom(pin, i + 1));
+}
+
+constexpr bool boardPinsUnique(unsigned int i = 0) {
+	return i >= BOARD_NUM_USED_PINS
+			|| (!boardPinUsedFrom(boardUsedPins[i], i + 1) && boardPinsUnique(i + 1));
+}
+
+constexpr bool boardPinsExist(unsigned int i = 0) {
+	return i >= BOARD_NUM_USED_PINS || (boardUsedPins[i] < BOARD_NUM_PINS && boardPinsExist(i + 1));
+}
+
+constexpr bool boardIsDigital(uint8_t pin) {
+	return pin < BOARD_NUM_PINS && boardPins[pin].port != BOARD_PORT_NONE;
+}
+
+constexpr bool boardIsAnalog(uint8_t pin) {
+	return pin >= A0 && pin < BOARD_NUM_PINS;
+}
+
+// Timer0 runs millis() and Timer1 the servo, so PWM only comes from their compare channels
+constexpr bool boardIsPwm(uint8_t pin) {
+	return pin < BOARD_NUM_PINS && boardPins[pin].timer != BOARD_TIMER_NONE
+			&& boardPins[pin].timer != BOARD_TIMER_1A && boardPins[pin].timer != BOARD_TIMER_1B;
+}
+
+static_assert(boardPinsExist(), "a pin in params.h isn't on the Nano");
+static_assert(boardPinsUnique(), "two functions share a pin in params.h");
+static_assert(boardIsPwm(MOTOR_LEFT) && boardIsPwm(MOTOR_RIGHT),
+		"the motors need Timer0 or Timer2 PWM pins, Timer1 belongs to the servo");
+static_assert((boardPins[MOTOR_LEFT].timer == BOARD_TIMER_2A || boardPins[MOTOR_LEFT].timer == BOARD_TIMER_2B)
+		&& (boardPins[MOTOR_RIGHT].timer == BOARD_TIMER_2A || boardPins[MOTOR_RIGHT].timer == BOARD_TIMER_2B),
+		"the motors share Timer2 (D3 and D11), Timer0 runs millis()");
+static_assert(BUMPER_PIN == 2 || BUMPER_PIN == 3, "the bumper needs an external interrupt pin (INT0/INT1)");
+static_assert(boardIsAnalog(BUTTON_COLLISION) && boardIsAnalog(BATTERY_PIN), "analog input on a digital pin");
+static_assert(boardIsAnalog(PHOTODIODE_TOP_LEFT) && boardIsAnalog(PHOTODIODE_BOTTOM_LEFT)
+		&& boardIsAnalog(PHOTODIODE_BOTTOM_RIGHT) && boardIsAnalog(PHOTODIODE_TOP_RIGHT),
+		"photodiode on a digital pin");
+static_assert(boardIsDigital(LED_COLLISION) && boardIsDigital(CAP_OUT_PIN) && boardIsDigital(CAP_IN_PIN)
+		&& boardIsDigital(ULTRASONIC_TRIGGER_PIN) && boardIsDigital(ULTRASONIC_ECHO_PIN)
+		&& boardIsDigital(SERVO_PIN), "digital I/O on an analog only pin");
+
+// ================================ REGISTER LOOKUPS =========================================
+
+// These fold away when the port or timer is a constant
+
+static inline __attribute__((always_inline)) volatile uint8_t& boardPortRegister(uint8_t port) {
+	return (port == BOARD_PORT_B) ? PORTB : (port == BOARD_PORT_C) ? PORTC : PORTD;
+}
+
+static inline __attribute__((always_inline)) volatile uint8_t& boardDdrRegister(uint8_t port) {
+	return (port == BOARD_PORT_B) ? DDRB : (port == BOARD_PORT_C) ? DDRC : DDRD;
+}
+
+static inline __attribute__((always_inline)) volatile uint8_t& boardPinRegister(uint8_t port) {
+	return (port == BOARD_PORT_B) ? PINB : (port == BOARD_PORT_C) ? PINC : PIND;
+}
+
+static inline __attribute__((always_inline)) volatile uint8_t& boardTimerControl(uint8_t timer) {
+	return (timer == BOARD_TIMER_0A || timer == BOARD_TIMER_0B) ? TCCR0A : TCCR2A;
+}
+
+static inline __attribute__((always_inline)) volatile uint8_t& boardTimerCompare(uint8_t timer) {
+	return (timer == BOARD_TIMER_0A) ? OCR0A : (timer == BOARD_TIMER_0B) ? OCR0B
+			: (timer == BOARD_TIMER_2A) ? OCR2A : OCR2B;
+}
+
+constexpr uint8_t boardTimerOutputBit(uint8_t timer) {
+	return (timer == BOARD_TIMER_0A) ? COM0A1 : (timer == BOARD_TIMER_0B) ? COM0B1
+			: (timer == BOARD_TIMER_2A) ? COM2A1 : COM2B1;
+}
+
+// ==================================== PIN I/O ==============================================
+
+/**
+ * @brief	Makes the pin an output.
+ */
+template <uint8_t pin> inline void pinOutput() {
+	static_assert(boardIsDigital(pin), "not a digital pin");
+#ifdef BOARD_ARDUINO_IO
+	pinMode(pin, OUTPUT);
+#else
+	boardDdrRegister(boardPins[pin].port) |= _BV(boardPins[pin].bit);
+#endif
+}
+
+/**
+ * @brief	Makes the pin an input.
+ *
+ * @param bool pullup : enable the internal pull-up
+ */
+template <uint8_t pin> inline void pinInput(bool pullup) {
+	static_assert(boardIsDigital(pin), "not a digital pin");
+#ifdef BOARD_ARDUINO_IO
+	pinMode(pin, pullup ? INPUT_PULLUP : INPUT);
+#else
+	boardDdrRegister(boardPins[pin].port) &= (uint8_t) ~_BV(boardPins[pin].bit);
+	if (pullup)
+		boardPortRegister(boardPins[pin].port) |= _BV(boardPins[pin].bit);
+	else
+		boardPortRegister(boardPins[pin].port) &= (uint8_t) ~_BV(boardPins[pin].bit);
+#endif
+}
+
+/**
+ * @brief	Drives an output pin high.
+ *
+ * Unlike digitalWrite() it leaves the pin's timer alone, don't use it on a pin set with pwmWrite().
+ */
+template <uint8_t pin> inline void pinHigh() {
+	static_assert(boardIsDigital(pin), "not a digital pin");
+#ifdef BOARD_ARDUINO_IO
+	digitalWrite(pin, HIGH);
+#else
+	boardPortRegister(boardPins[pin].port) |= _BV(boardPins[pin].bit);
+#endif
+}
+
+/**
+ * @brief	Drives an output pin low.
+ */
+template <uint8_t pin> inline void pinLow() {
+	static_assert(boardIsDigital(pin), "not a digital pin");
+#ifdef BOARD_ARDUINO_IO
+	digitalWrite(pin, LOW);
+#else
+	boardPortRegister(boardPins[pin].port) &= (uint8_t) ~_BV(boardPins[pin].bit);
+#endif
+}
+
+/**
+ * @brief	Reads a digital input pin.
+ *
+ * @return true if the pin is high
+ */
+template <uint8_t pin> inline bool pinRead() {
+	static_assert(boardIsDigital(pin), "not a digital pin");
+#ifdef BOARD_ARDUINO_IO
+	return digitalRead(pin) == HIGH;
+#else
+	return boardPinRegister(boardPins[pin].port) & _BV(boardPins[pin].bit);
+#endif
+}
+
+/**
+ * @brief	Writes a PWM duty to an output pin, the same as analogWrite().
+ *
+ * A duty of 0 takes the pin off its timer and drives it low, so it doesn't glitch high once a
+ * cycle in fast PWM. The pin has to be made an output first.
+ *
+ * @param uint8_t duty : the duty cycle, out of 255
+ */
+template <uint8_t pin> inline void pwmWrite(uint8_t duty) {
+	static_assert(boardIsPwm(pin), "not a Timer0/Timer2 PWM pin");
+#ifdef BOARD_ARDUINO_IO
+	analogWrite(pin, duty);
+#else
+	if (duty == 0) {
+		boardTimerControl(boardPins[pin].timer) &= (uint8_t) ~_BV(boardTimerOutputBit(boardPins[pin].timer));
+		boardPortRegister(boardPins[pin].port) &= (uint8_t) ~_BV(boardPins[pin].bit);
+	} else {
+		boardTimerCompare(boardPins[pin].timer) = duty;
+		boardTimerControl(boardPins[pin].timer) |= _BV(boardTimerOutputBit(boardPins[pin].timer));
+	}
+#endif
+}
+
+#endif  // __BOARD_H__
@@ -0,0 +1,41 @@
+/**
+ * @file bumper.h
+ *
+ * @brief Interrupt driven bumper that cuts the motors the moment the robot hits something.
+ *
+ * The bumper switch pulls BUMPER_PIN (INT0) low. The interrupt disconnects both motor
+ * outputs from their timers and drives them low straight away, then latches the collision
+ * so the planning phase can pick it up on its next pass. The latch holds while the switch is
+ * closed and for BUMPER_HOLD_MS after it opens, so a bumper that springs straight back still
+ * stops the robot for more than one pass.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __BUMPER_H__
+#define __BUMPER_H__
+
+#include "includes.h"
+
+/**
+ * @brief	Enables the pull-up on the bumper pin and attaches the collision interrupt.
+ */
+void initBumper();
+
+/**
+ * @brief	Checks if the bumper interrupt has fired since the latch was last released.
+ *
+ * @return true if a collision is latched, false otherwise
+ */
+bool bumperLatched();
+
+/**
+ * @brief	Releases the collision latch once the bumper has been open for BUMPER_HOLD_MS.
+ */
+void updateBumperLatch();
+
+#endif  // __BUMPER_H__
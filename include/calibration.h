@@ -0,0 +1,94 @@
+/**
+ * @file calibration.h
+ *
+ * @brief Calibration values kept in EEPROM across power cycles.
+ *
+ * Everything measured on a particular robot, rather than fixed by the design, lives in one
+ * calibrationStruct: the photodiode baselines, the motor balance, the capacitive touch
+ * threshold, the sonar offset and the servo limits. loadCalibration() reads it back at boot,
+ * before anything that uses it is set up. Until then, or when nothing usable is stored, it
+ * holds the compiled defaults from params.h.
+ *
+ * Each record carries CAL_VERSION and a CRC. One written by firmware with a different layout,
+ * or cut short by a power loss, is skipped and the next newest good one is used instead.
+ *
+ * An EEPROM cell lasts about 100,000 writes, so saves rotate through CAL_SLOTS slots, each
+ * record numbered one higher than the last. Boot reads just the slot headers to find the
+ * newest, then only that record in full. Writing a byte takes 3.4 ms with the CPU stalled,
+ * so only bytes that changed are written and runtime saves are kept to CAL_SAVE_INTERVAL_MS.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __CALIBRATION_H__
+#define __CALIBRATION_H__
+
+#include "includes.h"
+
+// Has to match NUM_PHOTODIODES, checked in calibration.cpp
+#define CAL_NUM_PHOTODIODES 4
+
+/*
+ * @brief Per-robot calibration, as stored in each EEPROM slot
+ *
+ * Laid out so there is no padding on the host either. Any change here needs CAL_VERSION bumped.
+ */
+typedef struct _calibrationStruct {
+	uint8_t version;				// CAL_VERSION
+	int8_t motorBalance;				// see setMotorBalance()
+	uint16_t sequence;				// newest record wins
+	int16_t photodiodeBaseline[CAL_NUM_PHOTODIODES];	// mV taken off each photodiode, indexed by PHOTODIODE
+	uint16_t capThreshold;				// tau that counts as a touch
+	int8_t sonarOffsetCm;				// added to every sonar reading
+	uint8_t servoMin;				// deg
+	uint8_t servoMax;				// deg
+	uint8_t servoStart;				// deg, where the servo rested last
+	uint16_t crc;					// CRC-CCITT of everything above
+} calibrationStruct;
+
+#define DEFAULT_CALIBRATION_STRUCT calibrationStruct { \
+										.version = CAL_VERSION, \
+										.motorBalance = RIGHT_MOTOR_BALANCE_FACTOR, \
+										.sequence = 0, \
+										.photodiodeBaseline = {0, 0, 0, 0}, \
+										.capThreshold = CAP_SENSOR_TAU_THRESHOLD, \
+										.sonarOffsetCm = 0, \
+										.servoMin = SERVO_ANGLE_MIN, \
+										.servoMax = SERVO_ANGLE_MAX, \
+										.servoStart = SERVO_ANGLE_START, \
+										.crc = 0, \
+									}
+
+extern calibrationStruct calibration;
+
+/**
+ * @brief	Loads the newest good record from EEPROM, or the defaults when there is none.
+ *
+ * Call first thing in setup().
+ *
+ * @return bool : true if a stored record was loaded
+ */
+bool loadCalibration();
+
+/**
+ * @brief	Writes the current calibration to the next EEPROM slot.
+ *
+ * Blocks for 3.4 ms per byte that differs from what the slot held.
+ */
+void saveCalibration();
+
+/**
+ * @brief	Remembers where the servo came to rest, so the next boot starts there.
+ *
+ * Only saves once the angle has moved CAL_SERVO_SAVE_DEG from the stored one, and at most
+ * once every CAL_SAVE_INTERVAL_MS.
+ *
+ * @param int angle : the resting servo angle (deg)
+ */
+void saveServoRest(int angle);
+
+#endif  // __CALIBRATION_H__
@@ -12,15 +12,16 @@
 #define __CAPACITIVE_TOUCH_H__
 
 #include "includes.h"
+#if FEATURE_CAP_TOUCH
 #include <CapacitiveSensor.h>
+#endif
 
-#define CAP_OUT_PIN         7 
-#define CAP_IN_PIN  9 
 #define CAP_SENSOR_SAMPLES 40
 #define CAP_SENSOR_TAU_THRESHOLD 300 
 
 enum CAP_STATE {CAP_WAITING, CAP_PRESSED, CAP_RELEASED};
 
+#if FEATURE_CAP_TOUCH
 /**
  * This function will compute the tau transient value of the capacitive sensor.
  *
@@ -34,6 +35,12 @@ long computeTau();
  * @return true if touch detected, false otherwise
  */
 bool detectCapTouch();
+#else
+// Compiled out, see profiles.h. Never touched, so calibration never runs either.
+static inline bool detectCapTouch() {
+	return false;
+}
+#endif
 
 
 #endif
@@ -16,10 +16,31 @@
 
 #include "includes.h"
 #include "robot_states.h"
+#include "memory_monitor.h"
+#include "deadline_monitor.h"
 
 #define SENSOR_DATA_BLOB_HEADER 0xAA
 #define ACTION_DATA_BLOB_HEADER 0xBB
 #define PIN_DATA_BLOB_HEADER 0xCC
+#define MEMORY_DATA_BLOB_HEADER 0xDD
+#define BATTERY_DATA_BLOB_HEADER 0xEE
+#define PROFILER_DATA_BLOB_HEADER 0xAB
+#define PIN_SUMMARY_DATA_BLOB_HEADER 0xCD
+#define PIN_HISTOGRAM_DATA_BLOB_HEADER 0xCE
+#define DEADLINE_DATA_BLOB_HEADER 0xDA
+#define DEADLINE_RESET_DATA_BLOB_HEADER 0xDB
+
+// Payload length that follows each header
+#define SENSOR_DATA_BLOB_LENGTH 3
+#define ACTION_DATA_BLOB_LENGTH 3
+#define PIN_DATA_BLOB_LENGTH 5
+#define MEMORY_DATA_BLOB_LENGTH 7
+#define BATTERY_DATA_BLOB_LENGTH 7
+#define PROFILER_DATA_BLOB_LENGTH 8
+#define PIN_SUMMARY_DATA_BLOB_LENGTH 8
+#define PIN_HISTOGRAM_DATA_BLOB_LENGTH 8
+#define DEADLINE_DATA_BLOB_LENGTH 7
+#define DEADLINE_RESET_DATA_BLOB_LENGTH 8
 
 #define DATA_BLOB_DATA_TYPE uint64_t
 #define DATA_BLOB_DATA_SIZE (sizeof(DATA_BLOB_DATA_TYPE))
@@ -29,7 +50,17 @@
 #define COMM_STATUS_FAIL 1
 #define STATUS_DATA_BLOB_FILLED 2
 
-#define NEW_DATA_BLOB() (struct dataBlob*)malloc(sizeof(struct dataBlob))
+#if defined(__AVR__)
+#define BLOB_MALLOC malloc
+#define BLOB_FREE free
+#else
+// The host build takes the blobs from the shim's model of the AVR heap, see sim_hardware.h
+#define BLOB_MALLOC simMalloc
+#define BLOB_FREE simFree
+#endif
+
+#define NEW_DATA_BLOB() allocateDataBlob()
+#define FREE_DATA_BLOB(blob) BLOB_FREE(blob)
 
 
 /*
@@ -41,6 +72,13 @@ struct dataBlob {
 	uint8_t dataUsed; 
 };
 
+/*
+ * @brief Allocates a dataBlob, and notes the heap top for the memory monitor
+ *
+ * @return dataBlob*. Must free with FREE_DATA_BLOB() when done
+ */
+struct dataBlob* allocateDataBlob();
+
 /*
  * @brief Creates a new, empty dataBlob
  *
@@ -69,6 +107,55 @@ struct dataBlob* newSensorDataBlob();
  */
 struct dataBlob* newPinDataBlob();
 
+/*
+ * @brief Creates a new, empty dataBlob
+ *
+ * @return dataBlob*. Must free when done
+ */
+struct dataBlob* newMemoryDataBlob();
+
+/*
+ * @brief Creates a new, empty dataBlob
+ *
+ * @return dataBlob*. Must free when done
+ */
+struct dataBlob* newBatteryDataBlob();
+
+/*
+ * @brief Creates a new, empty dataBlob
+ *
+ * @return dataBlob*. Must free when done
+ */
+struct dataBlob* newProfilerDataBlob();
+
+/*
+ * @brief Creates a new, empty dataBlob
+ *
+ * @return dataBlob*. Must free when done
+ */
+struct dataBlob* newPinSummaryDataBlob();
+
+/*
+ * @brief Creates a new, empty dataBlob
+ *
+ * @return dataBlob*. Must free when done
+ */
+struct dataBlob* newPinHistogramDataBlob();
+
+/*
+ * @brief Creates a new, empty dataBlob
+ *
+ * @return dataBlob*. Must free when done
+ */
+struct dataBlob* newDeadlineDataBlob();
+
+/*
+ * @brief Creates a new, empty dataBlob
+ *
+ * @return dataBlob*. Must free when done
+ */
+struct dataBlob* newDeadlineResetDataBlob();
+
 /*
  * @brief Marshalls a byte of data into the next open position in a dataBlob object
  *
@@ -87,7 +174,17 @@ COMM_STATUS dataMarshall_uint8(struct dataBlob* dataBlob, uint8_t data);
  *
  * @return A status code indicating success or failure
  */
-COMM_STATUS dataMarshall_uint16(struct dataBlob* dataBlob, uint8_t data);
+COMM_STATUS dataMarshall_uint16(struct dataBlob* dataBlob, uint16_t data);
+
+/*
+ * @brief Marshalls four bytes of data into the next open position in a dataBlob object
+ *
+ * @param dataBlob A pointer to the dataBlob
+ * @param data The four bytes of data
+ *
+ * @return A status code indicating success or failure
+ */
+COMM_STATUS dataMarshall_uint32(struct dataBlob* dataBlob, uint32_t data);
 
 /*
  * @brief Marshalls a four-bit float value into the next open position in a dataBlob object
@@ -111,6 +208,8 @@ COMM_STATUS sendMarshalledData(struct dataBlob* dataBlob);
 /**
  * @brief Marshalls analogPin data and sends it down the wire.
  *
+ * One frame per reading, see pin_aggregate.h for summaries that keep up with the loop.
+ *
  * @param pin The pin being read
  * @param data The data to send over the wire
  *
@@ -123,21 +222,21 @@ COMM_STATUS sendPinData(uint8_t pin, float data);
  *
  * @param msg A pointer to the string mesage
  */
-void println(char* msg);
+void println(const char* msg);
 
 /*
  * @brief A shorter version of Serial.print
  *
  * @param msg A pointer to the string mesage
  */
-void print(char* msg);
+void print(const char* msg);
 
 /*
  * @brief Prints a new line on the Serial appended with "DEBUG: "
  *
  * @param msg A pointer to the string mesage
  */
-void debug(char* msg);
+void debug(const char* msg);
 
 /*
  * @brief sends the robot data found within a detectionDataStruct down the wire
@@ -161,4 +260,32 @@ void printRobotActions(actionStateStruct* actions);
  */
 void printRobotState(detectionDataStruct* data, actionStateStruct* actions);
 
+/*
+ * @brief Sends the robot's memory usage down the wire
+ *
+ * @param stats* A pointer to the robot's memory stats
+ */
+void printMemoryState(memoryStatsStruct* stats);
+
+/*
+ * @brief Sends the battery voltage, runtime estimate and governor state down the wire
+ *
+ * @param power The current power mode
+ */
+void printBatteryState(uint8_t power);
+
+/*
+ * @brief Sends each phase's overrun count and longest run since the last report down the wire
+ *
+ * Starts a new window for the longest run.
+ */
+void printDeadlineState();
+
+/*
+ * @brief Sends the record of a watchdog reset down the wire
+ *
+ * @param record* A pointer to the record, see takeDeadlineReset()
+ */
+void printDeadlineReset(deadlineRecordStruct* record);
+
 #endif  // __COMMUNICATE_H__
@@ -0,0 +1,114 @@
+/**
+ * @file deadline_monitor.h
+ *
+ * @brief Times each phase of loop() against its budget, behind the AVR watchdog.
+ *
+ * loop() brackets detection, planning and action with beginPhase() and ends with endLoop(). The
+ * watchdog is only kicked at the end of a pass where every phase finished within its budget, so
+ * DEADLINE_WATCHDOG_TIMEOUT without a good pass, a hang or a run of slow ones, fires it.
+ *
+ * It runs in interrupt and reset mode. The first timeout runs the watchdog interrupt, which
+ * stops both wheels the way the bumper does and writes the phase that overran and the time to
+ * deadlineRecord, which sits in .noinit and so survives the reset the second timeout brings. A
+ * loop that is only slow keeps running until then, so the motor layer holds the wheels stopped
+ * (deadlineStopped()).
+ * The next boot finds it there; the telemetry link reports it once (takeDeadlineReset()).
+ *
+ * A hang with interrupts off never runs the interrupt, and so is never reset either.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __DEADLINE_MONITOR_H__
+#define __DEADLINE_MONITOR_H__
+
+#include <stdint.h>
+#include <avr/wdt.h>
+
+// Marks deadlineRecord as written by this firmware rather than left over from power on
+#define DEADLINE_MAGIC 0x5AD1
+
+// How often the per-phase latency frames are sent with telemetry on, see profiles.h (ms)
+#define DEADLINE_REPORT_INTERVAL 5000
+
+/*
+ * @brief The phases of loop() the monitor times
+ */
+enum DEADLINE_PHASE {
+	PHASE_DETECTION,
+	PHASE_PLANNING,
+	PHASE_ACTION,
+	NUM_PHASES,
+};
+
+#define DEADLINE_PHASE_NONE 0xFF
+// Blamed when the watchdog fires outside of the phases, in setup() say
+#define DEADLINE_PHASE_OUTSIDE NUM_PHASES
+
+/*
+ * @brief Timing of one phase since boot
+ */
+typedef struct _phaseStatsStruct {
+	uint32_t runs;
+	uint32_t lastUs;
+	uint32_t maxUs;			// longest since boot
+	uint32_t windowMaxUs;		// longest since the last latency report
+	uint16_t overruns;		// runs over budget, stops counting at 0xFFFF
+} phaseStatsStruct;
+
+/*
+ * @brief What the watchdog interrupt left behind, kept in .noinit across the reset
+ */
+typedef struct _deadlineRecordStruct {
+	uint16_t magic;
+	uint8_t phase;			// phase that overran, DEADLINE_PHASE_NONE if the watchdog hasn't fired
+	uint8_t resets;			// watchdog resets since power on
+	uint32_t atMs;			// millis() when the watchdog interrupt ran
+	uint16_t phaseMs;		// how long the phase had run by then, or took if it had finished
+} deadlineRecordStruct;
+
+extern const uint32_t phaseBudgetUs[NUM_PHASES];
+extern phaseStatsStruct phaseStats[NUM_PHASES];
+extern deadlineRecordStruct deadlineRecord;
+
+/**
+ * @brief	Picks up a record left by a watchdog reset and starts the watchdog.
+ *
+ * Call last in setup(), the calibration drive there runs longer than the watchdog allows.
+ */
+void initDeadlineMonitor();
+
+/**
+ * @brief	Ends the phase running, if any, and starts timing the next one.
+ *
+ * @param uint8_t phase : a DEADLINE_PHASE
+ */
+void beginPhase(uint8_t phase);
+
+/**
+ * @brief	Ends the last phase, and kicks the watchdog if every phase this pass was within budget.
+ */
+void endLoop();
+
+/**
+ * @brief	Checks if the watchdog interrupt has stopped the wheels, which then stay stopped until
+ * 		the reset.
+ *
+ * @return true once the watchdog interrupt has run, false otherwise
+ */
+bool deadlineStopped();
+
+/**
+ * @brief	Hands over the record of the watchdog reset this boot came out of, once.
+ *
+ * @param deadlineRecordStruct* record : filled in when there is one
+ *
+ * @return true the first time it's called after a watchdog reset, false otherwise
+ */
+bool takeDeadlineReset(deadlineRecordStruct* record);
+
+#endif  // __DEADLINE_MONITOR_H__
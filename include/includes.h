@@ -16,14 +16,30 @@
 #include <string.h>
 #include <stdlib.h>
 #include <Arduino.h>
-#include <Servo.h>
 #include <NewPing.h>
 
 #include "params.h"
+#include "board.h"
+#if FEATURE_SERVO
+#include <Servo.h>
+#endif
 #include "robot_states.h"
 #include "init.h"
 #include "communicate.h"
 #include "capacitive_touch.h"
 #include "lightDirection.h"
+#include "oversample.h"
+#include "memory_monitor.h"
+#include "deadline_monitor.h"
+#include "bumper.h"
+#include "servo_planner.h"
+#include "search.h"
+#include "tracker.h"
+#include "motor.h"
+#include "battery.h"
+#include "power.h"
+#include "calibration.h"
+#include "profiler.h"
+#include "pin_aggregate.h"
 
 #endif  // __INCLUDES_H__
@@ -22,19 +22,162 @@
 #define LIGHT_LEFT 0X1000
 typedef uint16_t LIGHT_DIR;
 
+// Index of each photodiode in photodiodeVoltages
+#define NUM_PHOTODIODES 4
+enum PHOTODIODE {PD_TOP_LEFT, PD_BOTTOM_LEFT, PD_BOTTOM_RIGHT, PD_TOP_RIGHT};
+
+// Voltages read by the last call to detectLightDirection()
+extern float photodiodeVoltages[NUM_PHOTODIODES];
+
+// ============================= PATTERN LOOKUP =====================================
+
+// Which photodiodes see light, one bit per PHOTODIODE
+#define LIGHT_MASK_TOP_LEFT     (1 << PD_TOP_LEFT)
+#define LIGHT_MASK_BOTTOM_LEFT  (1 << PD_BOTTOM_LEFT)
+#define LIGHT_MASK_BOTTOM_RIGHT (1 << PD_BOTTOM_RIGHT)
+#define LIGHT_MASK_TOP_RIGHT    (1 << PD_TOP_RIGHT)
+#define NUM_LIGHT_PATTERNS (1 << NUM_PHOTODIODES)
+
+// Where the light is, to the nearest 45 degrees, as seen by the array
+enum LIGHT_BEARING {BEARING_NONE, BEARING_AHEAD, BEARING_UP, BEARING_UP_RIGHT, BEARING_RIGHT,
+		BEARING_DOWN_RIGHT, BEARING_DOWN, BEARING_DOWN_LEFT, BEARING_LEFT, BEARING_UP_LEFT,
+		NUM_BEARINGS};
+
+// Every pattern of lit photodiodes, indexed by mask. A lone diode means the light is off
+// towards its corner, and two opposite corners mean it sits between them.
+static constexpr uint8_t lightPatternBearings[NUM_LIGHT_PATTERNS] = {
+	BEARING_NONE,			// none
+	BEARING_UP_LEFT,		// top left
+	BEARING_DOWN_LEFT,		// bottom left
+	BEARING_LEFT,			// top left, bottom left
+	BEARING_DOWN_RIGHT,		// bottom right
+	BEARING_AHEAD,			// top left, bottom right
+	BEARING_DOWN,			// bottom left, bottom right
+	BEARING_DOWN_LEFT,		// all but top right
+	BEARING_UP_RIGHT,		// top right
+	BEARING_UP,				// top left, top right
+	BEARING_AHEAD,			// bottom left, top right
+	BEARING_UP_LEFT,		// all but bottom right
+	BEARING_RIGHT,			// bottom right, top right
+	BEARING_UP_RIGHT,		// all but bottom left
+	BEARING_DOWN_RIGHT,		// all but top left
+	BEARING_AHEAD,			// all
+};
+
+// Direction flags for each bearing, which the planning phase turns into drive and servo moves.
+// The light tracker (tracker.h) steers from the photodiode balance instead, and the servo too on
+// a quick loop, so with it these only say the light is in view and tilt the servo on a slow loop.
+static constexpr LIGHT_DIR lightBearingDirections[NUM_BEARINGS] = {
+	0,											// none
+	LIGHT_UP | LIGHT_DOWN | LIGHT_LEFT | LIGHT_RIGHT,	// ahead: drive straight, hold the servo
+	LIGHT_UP,
+	LIGHT_UP | LIGHT_RIGHT,
+	LIGHT_RIGHT,
+	LIGHT_DOWN | LIGHT_RIGHT,
+	LIGHT_DOWN,
+	LIGHT_DOWN | LIGHT_LEFT,
+	LIGHT_LEFT,
+	LIGHT_UP | LIGHT_LEFT,
+};
+
+constexpr LIGHT_DIR lightPatternDirection(uint8_t mask) {
+	return lightBearingDirections[lightPatternBearings[mask]];
+}
+
+// What the pairwise checks gave before the table, a side needing both of its diodes
+constexpr LIGHT_DIR lightPairwiseDirection(uint8_t mask) {
+	return ((mask & (LIGHT_MASK_TOP_LEFT | LIGHT_MASK_TOP_RIGHT)) == (LIGHT_MASK_TOP_LEFT | LIGHT_MASK_TOP_RIGHT) ? LIGHT_UP : 0)
+			| ((mask & (LIGHT_MASK_BOTTOM_LEFT | LIGHT_MASK_BOTTOM_RIGHT)) == (LIGHT_MASK_BOTTOM_LEFT | LIGHT_MASK_BOTTOM_RIGHT) ? LIGHT_DOWN : 0)
+			| ((mask & (LIGHT_MASK_TOP_LEFT | LIGHT_MASK_BOTTOM_LEFT)) == (LIGHT_MASK_TOP_LEFT | LIGHT_MASK_BOTTOM_LEFT) ? LIGHT_LEFT : 0)
+			| ((mask & (LIGHT_MASK_TOP_RIGHT | LIGHT_MASK_BOTTOM_RIGHT)) == (LIGHT_MASK_TOP_RIGHT | LIGHT_MASK_BOTTOM_RIGHT) ? LIGHT_RIGHT : 0);
+}
+
+// Swaps the left and right diodes, or the flags
+constexpr uint8_t lightMirrorMask(uint8_t mask) {
+	return ((mask & LIGHT_MASK_TOP_LEFT) ? LIGHT_MASK_TOP_RIGHT : 0)
+			| ((mask & LIGHT_MASK_TOP_RIGHT) ? LIGHT_MASK_TOP_LEFT : 0)
+			| ((mask & LIGHT_MASK_BOTTOM_LEFT) ? LIGHT_MASK_BOTTOM_RIGHT : 0)
+			| ((mask & LIGHT_MASK_BOTTOM_RIGHT) ? LIGHT_MASK_BOTTOM_LEFT : 0);
+}
+
+constexpr LIGHT_DIR lightMirrorDirection(LIGHT_DIR dir) {
+	return (dir & (LIGHT_UP | LIGHT_DOWN)) | ((dir & LIGHT_LEFT) ? LIGHT_RIGHT : 0)
+			| ((dir & LIGHT_RIGHT) ? LIGHT_LEFT : 0);
+}
+
+// What every pattern has to decode to, written out flag by flag rather than through the bearings
+#define LIGHT_AHEAD (LIGHT_UP | LIGHT_DOWN | LIGHT_LEFT | LIGHT_RIGHT)
+static constexpr LIGHT_DIR lightPatternsExpected[NUM_LIGHT_PATTERNS] = {
+	0,							// none
+	LIGHT_UP | LIGHT_LEFT,		// top left
+	LIGHT_DOWN | LIGHT_LEFT,	// bottom left
+	LIGHT_LEFT,					// top left, bottom left
+	LIGHT_DOWN | LIGHT_RIGHT,	// bottom right
+	LIGHT_AHEAD,				// top left, bottom right
+	LIGHT_DOWN,					// bottom left, bottom right
+	LIGHT_DOWN | LIGHT_LEFT,	// all but top right
+	LIGHT_UP | LIGHT_RIGHT,		// top right
+	LIGHT_UP,					// top left, top right
+	LIGHT_AHEAD,				// bottom left, top right
+	LIGHT_UP | LIGHT_LEFT,		// all but bottom right
+	LIGHT_RIGHT,				// bottom right, top right
+	LIGHT_UP | LIGHT_RIGHT,		// all but bottom left
+	LIGHT_DOWN | LIGHT_RIGHT,	// all but top left
+	LIGHT_AHEAD,				// all
+};
+
+// Checks every pattern from mask on: each decodes to lightPatternsExpected, light is never ignored, the patterns the pairwise checks
+// understood decode as before, and the table is the same either way round
+constexpr bool lightPatternsAsExpected(uint8_t mask = 0) {
+	return mask >= NUM_LIGHT_PATTERNS
+			|| (lightPatternDirection(mask) == lightPatternsExpected[mask] && lightPatternsAsExpected(mask + 1));
+}
+
+constexpr bool lightPatternsSeen(uint8_t mask = 1) {
+	return mask >= NUM_LIGHT_PATTERNS
+			|| (lightPatternBearings[mask] != BEARING_NONE && lightPatternsSeen(mask + 1));
+}
+
+constexpr bool lightPatternsKeepPairwise(uint8_t mask = 0) {
+	return mask >= NUM_LIGHT_PATTERNS
+			|| ((lightPairwiseDirection(mask) == 0 || lightPatternDirection(mask) == lightPairwiseDirection(mask))
+				&& lightPatternsKeepPairwise(mask + 1));
+}
+
+constexpr bool lightPatternsSymmetric(uint8_t mask = 0) {
+	return mask >= NUM_LIGHT_PATTERNS
+			|| (lightPatternDirection(lightMirrorMask(mask)) == lightMirrorDirection(lightPatternDirection(mask))
+				&& lightPatternsSymmetric(mask + 1));
+}
+
+static_assert(PD_TOP_LEFT < NUM_PHOTODIODES && PD_BOTTOM_LEFT < NUM_PHOTODIODES
+		&& PD_BOTTOM_RIGHT < NUM_PHOTODIODES && PD_TOP_RIGHT < NUM_PHOTODIODES, "photodiode index out of the mask");
+static_assert(lightPatternBearings[0] == BEARING_NONE, "no light has to decode as no light");
+static_assert(lightPatternsAsExpected(), "a pattern decodes differently from lightPatternsExpected");
+static_assert(lightPatternsSeen(), "a pattern of lit photodiodes decodes as no light");
+static_assert(lightPatternsKeepPairwise(), "a pattern decodes differently from the pairwise checks");
+static_assert(lightPatternsSymmetric(), "the pattern table isn't the same mirrored left to right");
+
+/**
+ * Reads all photodiodes in the array and looks the pattern of lit
+ * ones up in lightPatternBearings
+ *
+ * @return A collection of direction flags
+ */
+LIGHT_DIR detectLightDirection();
+
 /**
- * Determines if light is detected on a photodiode pin
+ * Compares the top and bottom photodiodes from the last detectLightDirection() call
  *
- * @return true if light is detected, false otherwise
+ * @return (top - bottom) / (top + bottom), positive when the light is above
  */
-bool isLight(int pin);
+float lightVerticalBalance();
 
 /**
- * Reads all photodiodes in the array and calculates the 
- * direction of the light
+ * Compares the left and right photodiodes from the last detectLightDirection() call
  *
- * @return A collection of direction flags
+ * @return (left - right) / (left + right), positive when the light is to the left
  */
-LIGHT_DIR detectLightDirection();
+float lightHorizontalBalance();
 
 #endif  // __lightDirection_h__
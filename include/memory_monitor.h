@@ -0,0 +1,76 @@
+/**
+ * @file memory_monitor.h
+ *
+ * @brief Tracks free SRAM, the stack high-water mark and the heap top at runtime.
+ *
+ * At boot the free region between the end of .bss and the top of the stack is painted
+ * with a canary byte. The deepest point the stack has ever reached is then found by
+ * scanning up from the heap top for the first byte that is no longer the canary. The scan
+ * starts from the highest the heap top has been, as free() lowers __brkval again but leaves
+ * the freed bytes behind, see noteHeapTop().
+ *
+ * On the host the shim models the RAM and avr-libc's heap, see sim_hardware.h.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __MEMORY_MONITOR_H__
+#define __MEMORY_MONITOR_H__
+
+#include <stdint.h>
+
+#define MEMORY_CANARY 0xC5
+
+// How often the painted region is rescanned (ms)
+#define MEMORY_CHECK_INTERVAL 250
+
+// How often the memory frame is sent with telemetry on, see profiles.h (ms)
+#define MEMORY_REPORT_INTERVAL 1000
+
+// Smallest tolerated gap between the heap top and the deepest stack (bytes)
+#define MEMORY_MARGIN_THRESHOLD 128
+
+// Memory status codes
+#define MEMORY_STATUS uint8_t
+#define MEMORY_OK 0
+#define MEMORY_LOW 1
+
+/*
+ * @brief Snapshot of the memory usage of the robot
+ */
+typedef struct _memoryStatsStruct {
+	uint16_t freeNow;		// bytes between the heap top and the current stack pointer
+	uint16_t minMargin;		// bytes between the heap top and the deepest stack ever seen
+	uint16_t heapTop;		// address of the heap top
+	MEMORY_STATUS status;
+} memoryStatsStruct;
+
+extern memoryStatsStruct memoryStats;
+
+/**
+ * @brief	Returns the number of bytes between the heap top and the stack pointer.
+ */
+uint16_t freeMemory();
+
+/**
+ * @brief	Notes the heap top, if it's the highest yet.
+ *
+ * Call straight after a malloc(), while the heap is at its highest. NEW_DATA_BLOB() does, and
+ * the telemetry blobs are the only thing the firmware allocates.
+ */
+void noteHeapTop();
+
+/**
+ * @brief	Rescans the painted region and updates memoryStats.
+ *
+ * Only rescans once every MEMORY_CHECK_INTERVAL ms.
+ *
+ * @return MEMORY_LOW if the margin has dropped below MEMORY_MARGIN_THRESHOLD, MEMORY_OK otherwise
+ */
+MEMORY_STATUS updateMemoryMonitor();
+
+#endif  // __MEMORY_MONITOR_H__
@@ -0,0 +1,112 @@
+/**
+ * @file motor.h
+ *
+ * @brief Drive motor layer with soft-start ramps and per-wheel trim.
+ *
+ * The drive functions only set a target PWM for each wheel. updateMotors() then walks the
+ * output up towards the target at no more than 255 counts per MOTOR_RAMP_MS, so the wheels
+ * don't pull stall current from the 9 V battery all at once. Slowing down and stopping are
+ * applied straight away. Every write is scaled by the wheel's trim, so both wheels turn at
+ * the same speed for the same command, and by the battery compensation, so they turn at the same
+ * speed whatever the battery voltage.
+ *
+ * calibrateMotorTrim() finds the trim by driving straight at the light and watching which
+ * way it drifts across the photodiode array.
+ *
+ * Both wheels run off Timer2, one on each compare channel, so they see the same PWM frequency.
+ * initMotors() sets it to MOTOR_PWM_HZ: phase correct at MOTOR_PWM_PRESCALER, or fast PWM with
+ * MOTOR_PWM_FAST. Timer0 keeps the core's settings for millis(), and Timer1 the servo's.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __MOTOR_H__
+#define __MOTOR_H__
+
+#include "includes.h"
+
+enum MOTOR_ID {MOTOR_ID_LEFT, MOTOR_ID_RIGHT, NUM_MOTORS};
+
+#ifdef MOTOR_PWM_FAST
+#define MOTOR_PWM_STEPS 256
+#else
+#define MOTOR_PWM_STEPS 510		// up to 255 and back down
+#endif
+#define MOTOR_PWM_HZ (F_CPU / ((uint32_t) MOTOR_PWM_PRESCALER * MOTOR_PWM_STEPS))
+
+// Timer2's CS2 bits for a prescaler, 0 if it hasn't got that one
+constexpr uint8_t motorPwmClockSelect(unsigned int prescaler) {
+	return (prescaler == 1) ? 1 : (prescaler == 8) ? 2 : (prescaler == 32) ? 3 : (prescaler == 64) ? 4
+			: (prescaler == 128) ? 5 : (prescaler == 256) ? 6 : (prescaler == 1024) ? 7 : 0;
+}
+
+static_assert(motorPwmClockSelect(MOTOR_PWM_PRESCALER), "Timer2 has no such MOTOR_PWM_PRESCALER");
+
+/*
+ * @brief State of one drive motor
+ */
+typedef struct _motorStruct {
+	uint8_t pin;
+	uint8_t target;		// PWM the drive functions asked for
+	uint8_t output;		// PWM after ramping, before trim
+	uint8_t trim;		// scale applied to every write, out of 255
+	uint8_t written;	// last PWM written to the pin
+} motorStruct;
+
+extern motorStruct motors[NUM_MOTORS];
+
+/**
+ * @brief	Sets Timer2 up for the motor PWM, stops both motors and loads the default trim.
+ */
+void initMotors();
+
+/**
+ * @brief	Sets the PWM a wheel should ramp towards.
+ *
+ * @param MOTOR_ID motor : the wheel
+ * @param uint8_t speed : the untrimmed PWM
+ */
+void setMotorSpeed(MOTOR_ID motor, uint8_t speed);
+
+/**
+ * @brief	Ramps each wheel towards its target and writes any PWM that changed.
+ *
+ * Call once per pass of loop().
+ */
+void updateMotors();
+
+/**
+ * @brief	Sets the scale applied on top of the trim to make up for the battery voltage.
+ *
+ * @param uint16_t scale : 256 being 1, see batteryCompensation()
+ */
+void setMotorSupplyScale(uint16_t scale);
+
+/**
+ * @brief	Sets the trim from a left/right balance.
+ *
+ * @param int balance : positive slows the right wheel, negative slows the left one (PWM counts out of 255)
+ */
+void setMotorBalance(int balance);
+
+/**
+ * @brief	Gets the current left/right balance, see setMotorBalance().
+ */
+int motorBalance();
+
+/**
+ * @brief	Finds the trim that makes the robot drive straight.
+ *
+ * Needs the light a few metres straight ahead and clear floor in between. Drives towards it
+ * in MOTOR_CAL_PASSES short bursts, and after each one moves the balance against the
+ * direction the light drifted across the photodiodes. Blocks until finished.
+ *
+ * @return int : the balance it settled on
+ */
+int calibrateMotorTrim();
+
+#endif  // __MOTOR_H__
@@ -0,0 +1,54 @@
+/**
+ * @file oversample.h
+ *
+ * @brief Oversampled and decimated ADC reads, for finer and steadier photodiode voltages.
+ *
+ * A single analogRead() is 10 bits, and in dim light the photodiodes only move a few counts with
+ * about as much noise on each conversion. Summing 4^n conversions and shifting the sum right by n
+ * gives a 10 + n bit reading with half the noise for every extra bit, as long as there is a count
+ * or so of noise to dither the conversions. Every extra bit takes 4 times as long, so each
+ * photodiode has its own count in PHOTODIODE_EXTRA_BITS; 0 is one plain analogRead().
+ *
+ * With ADC_NOISE_SLEEP defined the conversions run in ADC noise reduction sleep instead, with the
+ * CPU and its switching noise stopped while they run. So is the I/O clock: all three timers hold
+ * still for each conversion, which stretches the motor PWM and a servo pulse that happens to be
+ * running, and millis() loses the time.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __OVERSAMPLE_H__
+#define __OVERSAMPLE_H__
+
+#include "includes.h"
+
+// 4^3 10 bit conversions still sum into 16 bits
+#define OVERSAMPLE_MAX_EXTRA_BITS 3
+
+/**
+ * @brief	Reads a pin 4^extraBits times and decimates the sum.
+ *
+ * Folded into the pin's telemetry summary at 10 bits, see pin_aggregate.h.
+ *
+ * @param uint8_t pin : the analog pin
+ * @param uint8_t extraBits : bits past the ADC's 10, up to OVERSAMPLE_MAX_EXTRA_BITS
+ *
+ * @return The reading, out of SENSOR_MAX_OUT << extraBits
+ */
+uint16_t readOversampledCounts(uint8_t pin, uint8_t extraBits);
+
+/**
+ * @brief	Reads a pin 4^extraBits times, like readPinVoltage() with more resolution.
+ *
+ * @param uint8_t pin : the analog pin
+ * @param uint8_t extraBits : bits past the ADC's 10, up to OVERSAMPLE_MAX_EXTRA_BITS
+ *
+ * @return The voltage on the pin
+ */
+float readOversampledVoltage(uint8_t pin, uint8_t extraBits);
+
+#endif  // __OVERSAMPLE_H__
@@ -18,17 +18,49 @@
 #ifndef __PARAMS_H__
 #define __PARAMS_H__
 
+// Picks the debug build profile, see profiles.h
 // #define DEBUG_MODE true
+#include "profiles.h"
+
+// Pins are checked against the board at compile time, see board.h
 
 // Button input pins
 #define BUTTON_COLLISION   A6
+#define BUMPER_PIN         2	// must stay on INT0/INT1, see bumper.h
 
 // LED output pins
 #define LED_COLLISION	4
 
-// Motor output pins
-#define MOTOR_LEFT 5
+// Motor output pins, both on Timer2 so the wheels get the same PWM, see motor.h
+#define MOTOR_LEFT 11
 #define MOTOR_RIGHT 3
+// Timer2 clock divider for the motor PWM: 1 runs phase correct at 31.4 kHz, above hearing,
+// 8 at 3.9 kHz, 64 at 490 Hz like analogWrite()
+#define MOTOR_PWM_PRESCALER 1
+// Uncomment for fast PWM, at twice the frequency
+// #define MOTOR_PWM_FAST true
+
+// Soft start, see motor.h. Uncomment to write the drive PWM straight away instead.
+// #define MOTOR_NO_RAMP true
+#define MOTOR_RAMP_MS 300		// time to ramp from 0 to full PWM
+#define MOTOR_RAMP_START 40		// outputs jump straight to here, the wheels don't turn below it
+
+// I notice the right motor pulls more with the same PWM. Default balance until calibrated,
+// see calibration.h for the rest of the defaults kept in EEPROM.
+#define RIGHT_MOTOR_BALANCE_FACTOR 20
+#define MOTOR_MAX_BALANCE 64
+
+// Straight line trim calibration, see calibrateMotorTrim()
+#define MOTOR_CAL_SPEED 190		// PWM for each burst
+#define MOTOR_CAL_DRIVE_MS 1000
+#define MOTOR_CAL_SETTLE_MS 400
+#define MOTOR_CAL_PASSES 10
+#define MOTOR_CAL_MAX_STEP 16		// first balance adjustment, halved every time the drift flips
+#define MOTOR_CAL_TOLERANCE 0.01	// drift in horizontal photodiode balance that counts as straight
+
+// Battery divider input
+#define BATTERY_PIN A7
+#define BATTERY_DIVIDER_RATIO 2.0	// battery volts per volt at BATTERY_PIN
 
 // Photodiode input pins
 #define PHOTODIODE_TOP_LEFT A0
@@ -36,6 +68,10 @@
 #define PHOTODIODE_BOTTOM_RIGHT A2
 #define PHOTODIODE_TOP_RIGHT A3
 
+// Capacitive touch sensor pins, the sensor sits on CAP_IN_PIN
+#define CAP_OUT_PIN 7
+#define CAP_IN_PIN 9
+
 // Ultrasonic input pin
 #define ULTRASONIC_TRIGGER_PIN 10
 #define ULTRASONIC_ECHO_PIN 8
@@ -45,7 +81,15 @@
 #define SERVO_ANGLE_MIN 95
 #define SERVO_ANGLE_MAX 175
 #define SERVO_ANGLE_START 150 
-#define SERVO_ANGLE_DELTA 2
+#define SERVO_PULSE_MIN 544		// Servo library pulse width at 0 deg (us)
+#define SERVO_PULSE_MAX 2400	// Servo library pulse width at 180 deg (us)
+
+// Servo trajectory limits, see servo_planner.h
+#define SERVO_MAX_VELOCITY 150.0	// deg/s
+#define SERVO_MIN_VELOCITY 20.0		// slowest tracking speed while the light is off-centre (deg/s)
+#define SERVO_MAX_ACCEL 2000.0		// deg/s^2
+#define SERVO_ERROR_GAIN 2.5		// full speed at 40% top/bottom photodiode imbalance
+#define SERVO_MAX_DT_MS 50
 
 // ======================= SAMPLING PARAMETERS =============================
 
@@ -55,8 +99,105 @@
 #define VOLTAGE_MAX 5.10
 #define SENSOR_MAX_OUT 1024
 
+// Photodiode oversampling, see oversample.h. Extra bits of resolution for each photodiode,
+// indexed by PHOTODIODE; every bit takes 4 times the conversions, at about 112 us each.
+#define PHOTODIODE_EXTRA_BITS 0, 0, 0, 0
+// Uncomment to convert in ADC noise reduction sleep rather than with analogRead()
+// #define ADC_NOISE_SLEEP true
+
 // The max distance to consider for the ultrasonic sensor.
 #define ULTRASONIC_MAX_DIST 200
+#define ULTRASONIC_PING_INTERVAL 40
 #define COLLISION_DISTANCE 7
+#define BUMPER_HOLD_MS 1000		// a bumper collision is held this long after the switch opens again
+
+// Battery monitor, see battery.h
+#define BATTERY_SAMPLE_INTERVAL 500	// ms
+#define BATTERY_FILTER 0.2		// weight given to each new sample
+#define BATTERY_MIN_VOLTS 4.0		// below this the divider isn't connected, e.g. running off USB
+// Charge level thresholds and the discharge curve are generated, see battery_table.h
+#define BATTERY_NOMINAL_VOLTS 7.2	// drive voltage the motor PWM is scaled to
+#define BATTERY_MAX_COMPENSATION 1.4	// most the motor PWM is scaled up by
+// Uncomment to write the motor PWM without scaling it for the battery voltage
+// #define BATTERY_NO_COMPENSATION true
+#define BATTERY_REDUCED_HYSTERESIS 0.2	// back to normal power above BATTERY_REDUCED_VOLTS plus this
+#define BATTERY_REDUCED_SPEED SLOW	// fastest the robot drives in reduced power mode
+#define BATTERY_AVERAGE_MA 250		// average draw while driving, for the runtime estimate
+#define BATTERY_REPORT_INTERVAL 5000
+
+// Idle power mode, see power.h. Uncomment to keep running flat out while idle.
+// #define POWER_NO_IDLE true
+#define IDLE_LIGHT_INTERVAL 20		// ms between photodiode checks while idle
+#define IDLE_CAP_INTERVAL 200		// ms between capacitive touch checks while idle
+
+// Light tracker, see tracker.h. Uncomment to steer from the light flags alone.
+// #define LIGHT_NO_TRACKER true
+#define TRACKER_DEG_PER_BALANCE 67.5	// angle off the array axis per unit of photodiode balance
+#define TRACKER_ALPHA 0.3		// weight given to each new angle measurement
+#define TRACKER_BETA 0.02		// weight given to each new rate measurement
+#define TRACKER_MAX_RATE 180.0		// deg/s
+#define TRACKER_MAX_DT_MS 50
+#define TRACKER_LOOP_FILTER 0.05	// weight given to each new loop period
+#define TRACKER_ACTUATOR_LAG_MS 150	// motor and servo response on top of the loop period
+#define TRACKER_COAST_MS 400		// carries on along the estimate this long after losing the light
+#define TRACKER_STEER_DEG 8.0		// predicted bearing either side of ahead that is still straight
+#define TRACKER_SERVO_GAIN 4.0		// servo speed per degree off the predicted elevation (deg/s)
+#define TRACKER_SERVO_DEADBAND 2.0	// deg, and deg/s of light movement the servo rests through
+#define TRACKER_SERVO_MAX_LOOP_MS 15	// slowest loop the tracker still steers the servo at, the flags do beyond it
+
+// Light search, see search.h. Uncomment to sit still in the dark instead.
+// #define LIGHT_NO_SEARCH true
+#define SEARCH_DELAY_MS 1000		// light out of sight this long before searching
+#define SEARCH_TIMEOUT_MS 45000		// give up and idle after this long
+#define SEARCH_SPEED SLOW		// fastest the robot drives while searching
+#define SEARCH_SCAN_MS 4500		// pivoting at SEARCH_SPEED, a little over one revolution
+#define SEARCH_APPROACH_MS 3000		// driving towards the brightest heading between scans
+#define SEARCH_MIN_CONTRAST 0.2		// brightest less the darkest reading that counts as a light (V)
+#define SEARCH_RETURN_FRACTION 0.8	// of the scan's contrast that counts as facing the light again
+#define SEARCH_TILT_VELOCITY 120.0	// servo sweep while scanning (deg/s)
+#define SEARCH_TILT_MARGIN 2		// sweep turns round this far short of the servo limits (deg)
+#define SEARCH_TILT_GAIN 5.0		// servo speed per degree off the brightest tilt (deg/s)
+
+// Pin voltage summaries for the telemetry link, see pin_aggregate.h
+#define PIN_AGGREGATE_PINS PHOTODIODE_TOP_LEFT, PHOTODIODE_BOTTOM_LEFT, PHOTODIODE_BOTTOM_RIGHT, \
+		PHOTODIODE_TOP_RIGHT, BATTERY_PIN
+#define PIN_AGGREGATE_WINDOW_MS 500	// one summary frame per pin this often
+// Uncomment to send a histogram of each pin's readings with every summary
+// #define PIN_AGGREGATE_HISTOGRAM true
+
+// Sampling profiler, see profiler.h. 97.7 Hz: 976.6 Hz Timer0 overflows / DIVIDER.
+#define PROFILER_DIVIDER 10		// Timer0 overflows per sample
+#define PROFILER_RING 32		// samples queued for the link, a power of 2
+
+// Calibration store in EEPROM, see calibration.h
+#define CAL_VERSION 1			// bump whenever calibrationStruct changes
+#define CAL_EEPROM_BASE 0
+#define CAL_SLOTS 16			// slots saves rotate through, each lasts ~100,000 writes
+#define CAL_SLOT_SIZE 32
+#define CAL_SAVE_INTERVAL_MS 60000	// least time between saves made while running
+#define CAL_SERVO_SAVE_DEG 5		// servo rest angle change worth saving
+
+// Power on to the end of the first loop(), checked by `make boot` (ms)
+#define BOOT_BUDGET_MS 10
+
+// Loop deadline monitor, see deadline_monitor.h. Uncomment to time the phases with the watchdog off.
+// #define DEADLINE_NO_WATCHDOG true
+// Longest each phase of loop() may take, indexed by DEADLINE_PHASE (us). Detection allows for a
+// ping out to ULTRASONIC_MAX_DIST, action for every telemetry report landing on one pass.
+#define DEADLINE_BUDGET_US 25000, 5000, 100000
+#define DEADLINE_WATCHDOG_TIMEOUT WDTO_250MS	// no pass of loop() within budget for this long resets
+
+// Time-to-collision braking. Uncomment to go back to the plain COLLISION_DISTANCE stop.
+// #define COLLISION_FIXED_STOP true
+
+// Stop when COLLISION_DISTANCE is less than this far away at the current closing speed (ms)
+#define TTC_STOP_MS 100
+// Start slowing down when COLLISION_DISTANCE is less than this far away (ms)
+#define TTC_SLOW_MS 300
+// Slowest the robot is slowed to before stopping (out of 255)
+#define BRAKE_MIN_SCALE 160
+#define BRAKE_NONE 255
+// Weight given to each new closing speed measurement
+#define CLOSING_SPEED_FILTER 0.5
 
 #endif  // __PARAMS_H__
@@ -0,0 +1,73 @@
+/**
+ * @file pin_aggregate.h
+ *
+ * @brief Windowed summaries of the pin voltages for the telemetry link.
+ *
+ * Sending every reading (sendPinData()) takes 6 bytes a read, far more than the 9600 baud link
+ * carries at the loop rate, and reading less often misses anything short. Instead every
+ * readPinVoltage() of a pin in PIN_AGGREGATE_PINS is folded into that pin's running minimum,
+ * maximum, sum and count, in raw ADC counts. Every PIN_AGGREGATE_WINDOW_MS one summary frame per
+ * pin goes down the link and the window starts again:
+ *
+ *     header 0xCD, pin, count (saturates at 255), min, max, mean    uint16 counts, little endian
+ *
+ * so a spike between two frames still shows in the maximum.
+ *
+ * With PIN_AGGREGATE_HISTOGRAM defined each pin also keeps PIN_HISTOGRAM_BINS bins of 64 counts
+ * each, sent after its summary as frames of PIN_HISTOGRAM_FRAME_BINS bins:
+ *
+ *     header 0xCE, pin, first bin, bins    each the bin's share of the window out of 255,
+ *                                          at least 1 if anything landed in it
+ *
+ * Built into the telemetry and debug profiles; the sampling profile keeps the link for the
+ * profiler.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __PIN_AGGREGATE_H__
+#define __PIN_AGGREGATE_H__
+
+#include "includes.h"
+
+#define PIN_AGGREGATE_ENABLED (FEATURE_TELEMETRY && !FEATURE_PROFILER)
+
+#define PIN_HISTOGRAM_BINS 16
+#define PIN_HISTOGRAM_FRAME_BINS 6
+
+/*
+ * @brief Readings of one pin over the current window
+ */
+typedef struct _pinAggregateStruct {
+	uint16_t count;
+	uint16_t min;			// ADC counts
+	uint16_t max;
+	uint32_t sum;
+#ifdef PIN_AGGREGATE_HISTOGRAM
+	uint16_t histogram[PIN_HISTOGRAM_BINS];
+#endif
+} pinAggregateStruct;
+
+#if PIN_AGGREGATE_ENABLED
+/**
+ * @brief	Folds a reading into its pin's window, if the pin is in PIN_AGGREGATE_PINS.
+ *
+ * @param uint8_t pin : the pin that was read
+ * @param uint16_t counts : the raw ADC reading
+ */
+void aggregatePinSample(uint8_t pin, uint16_t counts);
+
+/**
+ * @brief	Sends a summary of every pin and starts a new window, once PIN_AGGREGATE_WINDOW_MS is up.
+ */
+void sendPinSummaries();
+#else
+// Compiled out, see profiles.h
+static inline void aggregatePinSample(uint8_t, uint16_t) {}
+#endif
+
+#endif  // __PIN_AGGREGATE_H__
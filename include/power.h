@@ -0,0 +1,40 @@
+/**
+ * @file power.h
+ *
+ * @brief Low power idle mode.
+ *
+ * While the robot is stopped, or can't see the light, there is nothing to do but wait for the
+ * light or a touch. Rather than spinning through loop() flat out, it sleeps in SLEEP_MODE_IDLE
+ * between passes. The photodiodes are still checked every IDLE_LIGHT_INTERVAL, so tracking
+ * resumes as soon as the light shows up, while the sonar is left off and the capacitive sensor
+ * is only sampled every IDLE_CAP_INTERVAL.
+ *
+ * Idle mode rather than power-save, as Timer0 has to keep millis() going and Timer1 has to
+ * keep the servo pulses coming. The Timer0 overflow wakes the CPU every 1.024 ms, the bumper
+ * interrupt wakes it straight away.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __POWER_H__
+#define __POWER_H__
+
+#include "includes.h"
+
+/**
+ * @brief	Switches off the peripherals the robot never uses (TWI and SPI).
+ */
+void initPower();
+
+/**
+ * @brief	Sleeps until millis() reaches the given time or the bumper is hit.
+ *
+ * @param unsigned long wakeMs : the time to wake up at
+ */
+void idleUntil(unsigned long wakeMs);
+
+#endif  // __POWER_H__
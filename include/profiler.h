@@ -0,0 +1,65 @@
+/**
+ * @file profiler.h
+ *
+ * @brief Statistical sampling profiler, built into the sampling profile.
+ *
+ * The phase timings show which of detection, planning and action is slow, but not which
+ * function inside it: time spent in NewPing::ping_cm(), CapacitiveSensor, analogRead() or the
+ * soft-float routines all lands on the caller. Instead, the Timer0 compare A interrupt samples
+ * the program counter it interrupted, once every PROFILER_DIVIDER Timer0 overflows (1.024 ms
+ * each). Over a few seconds the samples add up to where the time goes.
+ *
+ * Timer0 keeps running millis() off its overflow; the compare A interrupt is free, and its
+ * output on D6 stays disconnected, so the servo signal on that pin is untouched. The Arduino
+ * core runs Timer0 in fast PWM, where OCR0A is double buffered and only takes a new value at
+ * BOTTOM, so the compare matches once per overflow whatever the handler writes. OCR0A is left
+ * at PROFILER_COMPARE, halfway between the overflows millis() counts.
+ *
+ * Samples are word addresses, as the AVR stacks them. They queue in a PROFILER_RING entry ring
+ * and go down the telemetry link PROFILER_FRAME_SAMPLES to a frame, along with the number
+ * dropped because the ring was full. `profileSymbols.py` turns them back into function names
+ * against the .elf. The link carries nothing else in this build, so the state frames can't
+ * hold the samples up.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "includes.h"
+
+#define PROFILER_FRAME_SAMPLES 3
+#define PROFILER_COMPARE 128
+
+// Timer0 overflows every 64 * 256 cycles at 16 MHz (us)
+#define PROFILER_TIMER0_OVERFLOW_US 1024
+#define PROFILER_RATE_HZ (1000000.0 / (PROFILER_TIMER0_OVERFLOW_US * PROFILER_DIVIDER))
+
+#if FEATURE_PROFILER
+/**
+ * @brief	Starts sampling.
+ */
+void initProfiler();
+
+/**
+ * @brief	Sends every full frame of samples that fits in the serial TX buffer without waiting.
+ */
+void sendProfilerSamples();
+
+/**
+ * @brief	Takes one sample, called from the Timer0 compare A interrupt.
+ *
+ * @param uint16_t pc : the interrupted program counter (word address)
+ */
+extern "C" void profilerRecord(uint16_t pc) __attribute__ ((used));
+#else
+// Compiled out, see profiles.h
+static inline void initProfiler() {}
+#endif
+
+#endif  // __PROFILER_H__
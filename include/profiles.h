@@ -0,0 +1,100 @@
+/**
+ * @file profiles.h
+ *
+ * @brief Build profiles, and the subsystems each one compiles in.
+ *
+ * A profile is picked by defining one of PROFILE_RACE, PROFILE_TELEMETRY, PROFILE_DEBUG or
+ * PROFILE_SAMPLING when compiling (`make race`, `make telemetry`, ...). Without one the standard
+ * profile is built. Uncommenting DEBUG_MODE in params.h still picks the debug profile.
+ *
+ *     profile     cap touch  servo tilt  battery  telemetry  debug prints  profiler
+ *     race            -          -          -         -           -            -
+ *     standard        x          x          x         -           -            -
+ *     telemetry       x          x          x         x           -            -
+ *     debug           x          x          x         x           x            -
+ *     sampling        x          x          x         x           -            x
+ *
+ * The sampling profile is the standard robot with the sampling profiler sending its samples
+ * down the telemetry link in place of the state frames, see profiler.h.
+ *
+ * Each FEATURE_ flag is 0 or 1. A subsystem that is off is left out with #if, along with its
+ * library, so it costs no flash, SRAM or loop time at all: CapacitiveSensor and Servo are only
+ * included when used, and the calls that would pull the rest in are never compiled.
+ *
+ * Without the capacitive sensor the speed can't be changed, so the robot drives at
+ * ROBOT_START_SPEED from power on.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __PROFILES_H__
+#define __PROFILES_H__
+
+#if defined(DEBUG_MODE) && !defined(PROFILE_DEBUG)
+#define PROFILE_DEBUG
+#endif
+
+#if defined(PROFILE_RACE) + defined(PROFILE_TELEMETRY) + defined(PROFILE_DEBUG) + defined(PROFILE_SAMPLING) > 1
+#error "pick one build profile"
+#endif
+
+#if defined(PROFILE_RACE)
+#define PROFILE_NAME "race"
+#define FEATURE_CAP_TOUCH 0
+#define FEATURE_SERVO 0
+#define FEATURE_BATTERY 0
+#define FEATURE_TELEMETRY 0
+#define FEATURE_DEBUG 0
+#define FEATURE_PROFILER 0
+#define ROBOT_START_SPEED FAST
+
+#elif defined(PROFILE_TELEMETRY)
+#define PROFILE_NAME "telemetry"
+#define FEATURE_CAP_TOUCH 1
+#define FEATURE_SERVO 1
+#define FEATURE_BATTERY 1
+#define FEATURE_TELEMETRY 1
+#define FEATURE_DEBUG 0
+#define FEATURE_PROFILER 0
+#define ROBOT_START_SPEED SLOW
+
+#elif defined(PROFILE_DEBUG)
+#define PROFILE_NAME "debug"
+#define FEATURE_CAP_TOUCH 1
+#define FEATURE_SERVO 1
+#define FEATURE_BATTERY 1
+#define FEATURE_TELEMETRY 1
+#define FEATURE_DEBUG 1
+#define FEATURE_PROFILER 0
+#define ROBOT_START_SPEED SLOW
+
+#elif defined(PROFILE_SAMPLING)
+#define PROFILE_NAME "sampling"
+#define FEATURE_CAP_TOUCH 1
+#define FEATURE_SERVO 1
+#define FEATURE_BATTERY 1
+#define FEATURE_TELEMETRY 1
+#define FEATURE_DEBUG 0
+#define FEATURE_PROFILER 1
+#define ROBOT_START_SPEED SLOW
+
+#else
+#define PROFILE_NAME "standard"
+#define FEATURE_CAP_TOUCH 1
+#define FEATURE_SERVO 1
+#define FEATURE_BATTERY 1
+#define FEATURE_TELEMETRY 0
+#define FEATURE_DEBUG 0
+#define FEATURE_PROFILER 0
+#define ROBOT_START_SPEED SLOW
+#endif
+
+#if FEATURE_PROFILER && !FEATURE_TELEMETRY
+#error "the profiler sends its samples over the telemetry link"
+#endif
+
+#endif  // __PROFILES_H__
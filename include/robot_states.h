@@ -34,6 +34,27 @@
 #define COLLISION_ACTIVE	1
 #define COLLISION_INACTIVE 	0
 
+// Memory Phases
+#define MEMORY_STOP_INACTIVE	0
+#define MEMORY_STOP_ACTIVE	1
+
+// Idle Phases
+#define IDLE_INACTIVE	0
+#define IDLE_ACTIVE	1
+
+// Light Tracking Phases, see tracker.h
+#define TRACK_NONE	0
+#define TRACK_LOCKED	1
+#define TRACK_COASTING	2
+
+// Light Search Phases, see search.h
+#define SEARCH_INACTIVE	0
+#define SEARCH_WAITING	1
+#define SEARCH_SCAN	2
+#define SEARCH_TURN	3
+#define SEARCH_APPROACH	4
+#define SEARCH_GAVE_UP	5
+
 // Driving Phases
 #define DRIVE_STOP      0x00
 #define DRIVE_LEFT      0x01
@@ -50,9 +71,6 @@ enum BATTERY_LEVEL {BATTERY_DEAD, BATTERY_LOW, BATTERY_MED, BATTERY_HIGH};
 
 enum ROBOT_SPEED {STOPPED=0, SLOW=(int)(0.45*255), MEDIUM=(int)(0.75*255), FAST=255};
 
-// I notice the right motor pulls more with the same PWM 
-#define RIGHT_MOTOR_BALANCE_FACTOR 20 
-
 // ========================== STATE TRACKING VARIABLES ===============================
 
 /*
@@ -66,7 +84,9 @@ typedef struct _detectionDataStruct {
 		uint8_t down; 
 	} lightDetected;
 	uint8_t collisionDetected;
+	uint8_t brakeScale;
 	uint8_t capacitiveTouchDetected;
+	uint8_t memoryLow;
 } detectionDataStruct;
 
 /*
@@ -74,8 +94,14 @@ typedef struct _detectionDataStruct {
  */
 typedef struct _actionStateStruct {
 	uint8_t Collision;
+	uint8_t Brake;
 	uint8_t Drive;
 	uint8_t Servo; 
+	uint8_t Memory;
+	uint8_t Power;
+	uint8_t Idle;
+	uint8_t Search;
+	uint8_t Track;
 } actionStateStruct;
 
 #define NEW_DETECTION_DATA_STRUCT detectionDataStruct { \
@@ -86,13 +112,21 @@ typedef struct _actionStateStruct {
 											.down = DETECTION_FALSE, \
 										}, \
 										.collisionDetected = DETECTION_FALSE, \
+										.brakeScale = BRAKE_NONE, \
 										.capacitiveTouchDetected = DETECTION_FALSE, \
+										.memoryLow = DETECTION_FALSE, \
 									}
 
 #define NEW_ACTION_STATE_STRUCT actionStateStruct { \
 									.Collision = COLLISION_INACTIVE, \
+									.Brake = BRAKE_NONE, \
 									.Drive = DRIVE_STOP, \
 									.Servo = SERVO_MOVE_STOP, \
+									.Memory = MEMORY_STOP_INACTIVE, \
+									.Power = POWER_NORMAL, \
+									.Idle = IDLE_INACTIVE, \
+									.Search = SEARCH_INACTIVE, \
+									.Track = TRACK_NONE, \
 								}
 
 // ========================== DETECTION STATE FUNCTIONS =============================
@@ -102,6 +136,8 @@ typedef struct _actionStateStruct {
  *
  * Will poll all of the sensors, collecting and storing all the necessary data
  * into the data tracking variables. 
+ * While idle the sonar is skipped and the capacitive sensor is only checked
+ * every IDLE_CAP_INTERVAL.
  **/
 void RobotDetection();
 
@@ -114,13 +150,6 @@ void RobotDetection();
  **/
 float readPinVoltage(uint8_t pin);
 
-/**
- * @brief	Reads the pin connected to the battery and determines the its voltage.
- * 
- * Sets a global flag.
- */
-void readBatteryVoltage();
-
 /**
  * @brief	Checks to see if a given button is pressed.
  *
@@ -134,10 +163,30 @@ bool buttonPushed(uint8_t button_pin);
  * @brief	Checks to see if there is an obstacle in front of robot.
  *
  * Checks the ultrasonic sensor to see if path forward is blocked by an object.
+ * Also estimates the closing speed from successive pings and sets the brake
+ * scale from the time left until COLLISION_DISTANCE is reached.
  *
  * @return bool : true if object detected, false otherwise
  **/
-bool detectCollision();
+bool collisionDetected();
+
+/**
+ * @brief	Updates the closing speed estimate with a new sonar range.
+ *
+ * @param int previousCm : the range from the last ping, 0 if nothing was in range
+ * @param int currentCm : the range from this ping, 0 if nothing is in range
+ * @param unsigned long dtMs : time between the two pings
+ */
+void updateClosingSpeed(int previousCm, int currentCm, unsigned long dtMs);
+
+/**
+ * @brief	Computes how hard to brake for an obstacle at the given range.
+ *
+ * @param int distanceCm : the current sonar range, 0 if nothing is in range
+ *
+ * @return uint8_t : speed scale out of 255, 0 to stop, BRAKE_NONE for full speed
+ */
+uint8_t computeBrakeScale(int distanceCm);
 
 // ========================== PLANING STATE FUNCTIONS ==============================
 
@@ -154,7 +203,7 @@ void RobotPlanning();
  *
  * Sets action flag based upon current collision state:
  *    Collision Detected: stop the robot
- *    No collision detected: keep going
+ *    No collision detected: keep going, slowed down by the brake scale
  */
 void fsmCollisionDetection();
 
@@ -180,6 +229,9 @@ void fsmServoMovement();
 
 /**
  * @brief	State machine for managing battery indicator LEDS. If the battery is high, will set the flag to enable all three LEDS. If it is dead, the flag to turn off all three leds will be set.
+ *
+ * Also drops into reduced power mode below BATTERY_REDUCED_VOLTS, and back out once the
+ * battery reads BATTERY_REDUCED_HYSTERESIS above it.
  */
 void fsmBatteryVoltage();
 
@@ -188,6 +240,43 @@ void fsmBatteryVoltage();
  */
 void fsmCapacitiveTouch();
 
+/**
+ * @brief	State machine for managing the memory safety stop
+ *
+ * Sets the memory stop flag once the free SRAM margin has dropped too low.
+ */
+void fsmMemoryMonitor();
+
+/**
+ * @brief	State machine for managing the light tracker
+ *
+ * Updates the light estimate and, while there is a track, replaces the steering
+ * flags with ones for the predicted bearing, see tracker.h.
+ *     If the light will be left: move left
+ *     If the light will be right: move right
+ *     If the light will be ahead: move straight
+ */
+void fsmLightTracker();
+
+/**
+ * @brief	State machine for managing the light search
+ *
+ * Starts a search once the light has been out of sight for SEARCH_DELAY_MS, and
+ * moves it on until the light is seen again or it gives up, see search.h.
+ *     If the light is seen or the robot is stopped: no search
+ *     If the search gave up: stay that way until the light is seen
+ */
+void fsmLightSearch();
+
+/**
+ * @brief	State machine for managing the idle power mode
+ *
+ * Sets the idle flag while the robot is stopped or can't see the light, the
+ * servo is at rest, and it isn't in the middle of a capacitive touch or a
+ * light search.
+ */
+void fsmIdle();
+
 
 // ============================= ACTION STATE FUNCTIONS ======================================
 
@@ -205,14 +294,19 @@ void RobotAction();
 void debugRobotState();
 
 /**
- * @brief	Handles collision execution logic
+ * @brief	Drives the motors as the action flags say.
  *
- * Sets the collision LED.
- * 
- * @return status code if collision detected, 0 otherwise.
+ * Hands the motors to the light search while it is running, see searchDrive().
  */
 void handleDriveAction();
 
+/**
+ * @brief	Pivots or drives straight for the current light search phase.
+ *
+ * Never faster than SEARCH_SPEED, and slowed by the brake scale like any other drive.
+ */
+void searchDrive();
+
 /**
  * @brief	Handles collision execution logic
  *
@@ -225,15 +319,37 @@ void handleCollisionAction();
 /**
  * @brief	Moves the servo motor.
  *
- * Will move the servo motor up or down, based upon the condition flags set.
+ * Will move the servo motor up or down, based upon the condition flags set, or
+ * follow the light tracker while it has a track, or sweep it for the light search
+ * while that is running.
+ * The speed follows the servo trajectory limits, see servo_planner.h.
  */
 void handleServoAction();
 
+/**
+ * @brief	Stops the robot for good when memory is running out.
+ *
+ * Drops the speed to STOPPED and lights the builtin LED as the error indicator.
+ */
+void handleMemoryAction();
+
+/**
+ * @brief	Sleeps until the next idle check, if idle.
+ *
+ * Called last, so the rest of the action phase runs at the idle rate too.
+ */
+void handleIdleAction();
+
 /**
  * @brief	Updates the battery LEDS to indicate charge level.
  */
 void handleBatteryLEDAction();
 
+/**
+ * @brief	Scales the motor PWM for the battery voltage.
+ */
+void handleBatteryAction();
+
 /**
  * @brief	Will control the motors to drive in desired direction
  *
@@ -258,15 +374,19 @@ void toggleLEDs();
 /**
  * @brief 	Turns on an LED 
  *
- * @param 	uint8_t ledPin : the pin of the LED to turn on 
+ * @tparam 	ledPin : the pin of the LED to turn on 
  */
-void activateLED(uint8_t ledPin);
+template <uint8_t ledPin> inline void activateLED() {
+	pinHigh<ledPin>();
+}
 
 /**
  * @brief 	Turns of an LED
  *
- * @param 	uint8_t ledPin : the pin of the LED to disable
+ * @tparam 	ledPin : the pin of the LED to disable
  */
-void disableLED(uint8_t ledPin);
+template <uint8_t ledPin> inline void disableLED() {
+	pinLow<ledPin>();
+}
 
 #endif  // __ROBOT_STATES_H__
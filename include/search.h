@@ -0,0 +1,84 @@
+/**
+ * @file search.h
+ *
+ * @brief Active light search, for when none of the photodiodes can see the light.
+ *
+ * Once the light has been out of sight for SEARCH_DELAY_MS the robot scans for it: it pivots
+ * for SEARCH_SCAN_MS, a little over one revolution, while the servo sweeps the array between
+ * the calibrated limits. The brightest reading of the scan, summed over the photodiodes, and
+ * the tilt it was seen at are kept. The robot then holds the servo at that tilt and pivots on
+ * until the brightness comes back, and drives straight that way for SEARCH_APPROACH_MS before
+ * scanning again. A scan that saw nothing brighter than the room skips the turn and just
+ * drives on, so the scans spiral out from where the light was lost.
+ *
+ * The wheels only turn forwards, so the robot pivots on its right wheel rather than turning
+ * in place. Without encoders there is no heading to turn back to; the pivot just goes on
+ * until the light is as bright as it was.
+ *
+ * The search ends as soon as the light is seen, and gives up after SEARCH_TIMEOUT_MS so the
+ * robot can idle. Stopping the robot with the capacitive touch resets it.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __SEARCH_H__
+#define __SEARCH_H__
+
+#include "includes.h"
+
+/*
+ * @brief Progress of the light search, the phase itself is actionStates.Search
+ */
+typedef struct _lightSearchStruct {
+	unsigned long startMs;		// when the search started
+	unsigned long phaseMs;		// when the current phase started
+	float bestIntensity;		// brightest reading of the last scan (V)
+	float dimmestIntensity;		// darkest reading of the last scan, the room's ambient (V)
+	float bestTilt;			// servo angle the brightest reading was taken at (deg)
+	int8_t tiltDirection;		// which way the scan is sweeping the servo
+} lightSearchStruct;
+
+extern lightSearchStruct lightSearch;
+
+/**
+ * @brief	Starts a new search with a scan.
+ */
+void startLightSearch();
+
+/**
+ * @brief	Moves the search on using the photodiodes from the last detectLightDirection().
+ *
+ * Call it every pass the light is out of sight, starting from SEARCH_INACTIVE; it waits out
+ * SEARCH_DELAY_MS before the first scan.
+ *
+ * @param uint8_t phase : the current search phase, anything but SEARCH_GAVE_UP
+ * @param bool blocked : something is in the way
+ *
+ * @return uint8_t : the next search phase, SEARCH_GAVE_UP once SEARCH_TIMEOUT_MS is up
+ */
+uint8_t updateLightSearch(uint8_t phase, bool blocked);
+
+/**
+ * @brief	Sums the photodiodes from the last detectLightDirection() call.
+ *
+ * @return float : the total voltage (V)
+ */
+float lightIntensity();
+
+/**
+ * @brief	Picks the servo velocity for the search phase.
+ *
+ * Sweeps back and forth between the calibrated limits while scanning, and holds the tilt the
+ * brightest reading was taken at otherwise.
+ *
+ * @param uint8_t phase : the current search phase
+ *
+ * @return float : the target velocity for updateServoPlanner() (deg/s)
+ */
+float searchServoVelocity(uint8_t phase);
+
+#endif  // __SEARCH_H__
@@ -0,0 +1,67 @@
+/**
+ * @file servo_planner.h
+ *
+ * @brief Time based trajectory generator for the photodiode tilt servo.
+ *
+ * The servo position is integrated from a commanded angular velocity using the actual time
+ * elapsed between calls, so the tilt rate no longer depends on how fast loop() runs. The
+ * velocity is limited to SERVO_MAX_VELOCITY and may only change by SERVO_MAX_ACCEL per second.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __SERVO_PLANNER_H__
+#define __SERVO_PLANNER_H__
+
+#include "includes.h"
+
+/*
+ * @brief State of the servo trajectory
+ */
+typedef struct _servoPlanStruct {
+	float position;			// deg
+	float velocity;			// deg/s
+	unsigned long lastUpdateUs;
+} servoPlanStruct;
+
+extern servoPlanStruct servoPlan;
+
+/**
+ * @brief	Starts the trajectory at rest at the given angle.
+ *
+ * @param int angle : the angle the servo was last written to
+ */
+void initServoPlanner(int angle);
+
+/**
+ * @brief	Picks a tracking speed proportional to how far off-centre the light is.
+ *
+ * @param float balance : photodiode imbalance between -1 and 1
+ *
+ * @return float : speed between SERVO_MIN_VELOCITY and SERVO_MAX_VELOCITY (deg/s)
+ */
+float servoTrackingSpeed(float balance);
+
+/**
+ * @brief	Advances the trajectory by the time elapsed since the last call.
+ *
+ * @param float targetVelocity : the velocity to accelerate towards (deg/s, positive is up)
+ *
+ * @return float : the new servo angle (deg), clamped to the calibrated servo limits
+ */
+float updateServoPlanner(float targetVelocity);
+
+/**
+ * @brief	Converts a servo angle to the pulse width the Servo library would use for it.
+ *
+ * @param float angle : the angle (deg)
+ *
+ * @return uint16_t : the pulse width (us)
+ */
+uint16_t servoAngleToPulse(float angle);
+
+#endif  // __SERVO_PLANNER_H__
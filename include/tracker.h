@@ -0,0 +1,105 @@
+/**
+ * @file tracker.h
+ *
+ * @brief Alpha-beta filter on where the light is and how fast it is moving.
+ *
+ * The light flags only say which photodiodes are over the threshold right now, so the robot
+ * always steers for where the light was a loop and a motor lag ago. The tracker keeps an
+ * estimate of the light's bearing and elevation and their rates instead:
+ *
+ *     bearing    from the left/right photodiode balance, deg from straight ahead, positive left
+ *     elevation  the servo angle plus the top/bottom balance, so the servo's own movement
+ *                doesn't look like the light moving
+ *
+ * The balances are turned into angles with TRACKER_DEG_PER_BALANCE. Each pass the estimate is
+ * predicted on by the time since the last one, then pulled towards the new measurement by
+ * TRACKER_ALPHA, and the rate by TRACKER_BETA. Steering and the servo use the estimate
+ * predicted on by the lead: the measured loop period plus TRACKER_ACTUATOR_LAG_MS. The servo
+ * does only while the loop is quick enough, see trackerLeadsServo().
+ *
+ * With nothing over the threshold the estimate coasts on its rate for up to TRACKER_COAST_MS,
+ * so the robot carries on through a short dropout, then the track is dropped.
+ *
+ * There's nothing measuring the wheels, so the robot's own turning shows up in the bearing rate
+ * along with the light's.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#ifndef __TRACKER_H__
+#define __TRACKER_H__
+
+#include "includes.h"
+
+/*
+ * @brief Estimate of one angle and its rate
+ */
+typedef struct _trackerAxisStruct {
+	float angle;			// deg
+	float rate;			// deg/s
+} trackerAxisStruct;
+
+/*
+ * @brief State of the light tracker, whether it has a track is actionStates.Track
+ */
+typedef struct _lightTrackerStruct {
+	trackerAxisStruct bearing;
+	trackerAxisStruct elevation;
+	unsigned long lastUpdateUs;
+	unsigned long lastSeenUs;
+	float loopUs;			// filtered time between updates
+} lightTrackerStruct;
+
+extern lightTrackerStruct lightTracker;
+
+/**
+ * @brief	Moves the estimate on using the photodiodes from the last detectLightDirection().
+ *
+ * @param uint8_t state : TRACK_NONE, TRACK_LOCKED or TRACK_COASTING
+ *
+ * @return uint8_t : the new state, TRACK_LOCKED while any photodiode is over the threshold
+ */
+uint8_t updateLightTracker(uint8_t state);
+
+/**
+ * @brief	Gets how far ahead the commands are predicted.
+ *
+ * @return float : the lead (s)
+ */
+float trackerLead();
+
+/**
+ * @brief	Predicts the bearing of the light by the time the motors respond.
+ *
+ * @return float : deg from straight ahead, positive to the left
+ */
+float predictedBearing();
+
+/**
+ * @brief	Checks if the loop is quick enough for the tracker to steer the servo.
+ *
+ * The photodiodes see where the servo actually is, which trails the plan, and on a slow loop
+ * that lag and the filter's overshoot the light (18 deg at a 27 ms loop in make servo, 9 with no
+ * lead at all). Past TRACKER_SERVO_MAX_LOOP_MS the servo goes back to the photodiode flags, which
+ * slow down as the light centres.
+ *
+ * @return true if the filtered loop period is within TRACKER_SERVO_MAX_LOOP_MS, false otherwise
+ */
+bool trackerLeadsServo();
+
+/**
+ * @brief	Picks the servo velocity that keeps the array on the light.
+ *
+ * The light's elevation rate, plus a correction towards where it will be.
+ *
+ * @param float position : the current servo angle (deg)
+ *
+ * @return float : the target velocity for updateServoPlanner() (deg/s)
+ */
+float trackerServoVelocity(float position);
+
+#endif  // __TRACKER_H__
@@ -12,17 +12,38 @@
 #include "includes.h"
 
 void setup() {
+  // Everything below is set up from the stored calibration
+  loadCalibration();
+
   initPins();
 
+  initPower();
+
   initSerialComm();
 
+  initProfiler();
+
   initServo();
+
+  // Holding the capacitive sensor at power on runs the straight line trim calibration
+  if (detectCapTouch()) {
+    calibration.motorBalance = calibrateMotorTrim();
+    saveCalibration();
+  }
+
+  // Last, the calibration drive above runs well past the watchdog timeout
+  initDeadlineMonitor();
 }
 
 void loop() {
+  beginPhase(PHASE_DETECTION);
   RobotDetection();
 
+  beginPhase(PHASE_PLANNING);
   RobotPlanning();
 
+  beginPhase(PHASE_ACTION);
   RobotAction();
+
+  endLoop();
 }
@@ -0,0 +1,80 @@
+/**
+ * @file battery.cpp
+ *
+ * @brief Implementation of the battery monitor defined in battery.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "battery.h"
+#include "params.h"
+
+extern float batteryVoltage;
+
+void readBatteryVoltage() {
+	static unsigned long lastSample = 0;
+	bool connected = batteryVoltage >= BATTERY_MIN_VOLTS;
+
+	if (connected && millis() - lastSample < BATTERY_SAMPLE_INTERVAL)
+		return;
+	lastSample = millis();
+
+	float volts = readPinVoltage(BATTERY_PIN) * BATTERY_DIVIDER_RATIO;
+
+	// Start the filter from the first real reading, rather than climbing up from nothing
+	if (!connected) {
+		batteryVoltage = volts;
+	} else {
+		batteryVoltage += BATTERY_FILTER * (volts - batteryVoltage);
+	}
+}
+
+uint8_t batteryStateOfCharge(float volts) {
+	uint16_t millivolts = volts * 1000;
+
+	if (millivolts <= pgm_read_word(&batteryCurve[0]))
+		return 0;
+
+	// Curve runs from empty to full, interpolate between the two points either side
+	for (uint8_t i = 1; i < BATTERY_CURVE_POINTS; i++) {
+		uint16_t high = pgm_read_word(&batteryCurve[i]);
+
+		if (millivolts < high) {
+			uint16_t low = pgm_read_word(&batteryCurve[i - 1]);
+			return (i - 1) * BATTERY_CURVE_STEP + (uint32_t) BATTERY_CURVE_STEP * (millivolts - low) / (high - low);
+		}
+	}
+
+	return 100;
+}
+
+uint16_t batteryChargeLeft(float volts) {
+	return (uint32_t) batteryStateOfCharge(volts) * BATTERY_CAPACITY_MAH / 100;
+}
+
+uint16_t batteryRuntimeMinutes() {
+	uint16_t charge = batteryChargeLeft(batteryVoltage);
+	uint16_t reserve = batteryChargeLeft(BATTERY_DEAD_VOLTS);
+
+	if (charge <= reserve)
+		return 0;
+	return (uint32_t) (charge - reserve) * 60 / BATTERY_AVERAGE_MA;
+}
+
+uint16_t batteryCompensation() {
+#ifdef BATTERY_NO_COMPENSATION
+	return 256;
+#else
+	if (batteryVoltage <= 0)
+		return 256;
+
+	float scale = BATTERY_NOMINAL_VOLTS / batteryVoltage;
+	if (scale > BATTERY_MAX_COMPENSATION)
+		scale = BATTERY_MAX_COMPENSATION;
+	return scale * 256;
+#endif
+}
@@ -1,115 +1,206 @@
 """
 @file batteryDataAnalyis.py
 
-@brief A quick script that takes in a battery data script and performs calculations upon it.
-Will calculate the power used at any given moment and will then find the average capacity of that battery in 
-watt hours.
+@brief Turns battery discharge logs into the firmware's battery lookup table.
+
+Takes any number of discharge logs, each a CSV with a "Time (hours)" and a "Voltage" column logged
+across a fixed resistive load. For every log the capacity is integrated over the whole discharge
+and each sample is given the state of charge left at that point. The logs are grouped by battery
+type, taken from the start of the file name up to the first underscore (9V_battery_sheet.csv is a
+9V battery), and a polynomial voltage-against-state-of-charge curve is fitted to each type.
+
+With --header, a C++ header is generated for one type holding the curve as a PROGMEM table of
+voltages at every BATTERY_CURVE_STEP percent, the average capacity, and the voltage thresholds
+used by fsmBatteryVoltage().
+
+    python3 src/batteryDataAnalyis.py data/9V_*.csv --header include/battery_table.h
 
 @author Wesley Campbell
-@date 2026-02-26 
-@version 1.0.0
+@date 2026-10-18
+@version 2.0.0
 """
 
-import pandas as pd
-import matplotlib.pyplot as plt
-import matplotlib.ticker as ticker
+import argparse
+import os
+import sys
 
-data_dir = "~/Code/byu/lightTrackingRobot/data"
-data_file= data_dir + "/9V_battery_sheet.csv"
+import numpy as np
 
-data_file_columns = ["Time (hours)", "Voltage"]
+TIME_COLUMN = "Time (hours)"
+VOLTAGE_COLUMN = "Voltage"
 
-RESISTANCES = [200] 
+DEFAULT_LOAD_OHMS = 200
+DEFAULT_DEGREE = 5
 
-battery_capacities = {}
+# Percent state of charge between table points
+CURVE_STEP = 5
 
-def import_data(file_path, columns):
-    df = pd.read_csv(file_path, usecols=columns)
-    return df
+# State of charge each firmware threshold sits at (percent)
+THRESHOLDS = {
+    "BATTERY_HIGH_VOLTS": 85,
+    "BATTERY_MED_VOLTS": 40,
+    "BATTERY_REDUCED_VOLTS": 20,
+    "BATTERY_DEAD_VOLTS": 15,
+}
 
-def save_data(df, filename):
-    df.to_csv(data_dir + "/" + filename + '.csv')
 
-def power(voltage, resistance):
-    return voltage * voltage / resistance;
+class DischargeLog:
+    def __init__(self, path, hours, volts, load_ohms):
+        self.path = path
+        self.hours = hours
+        self.volts = volts
 
-def midpoint_time_values(time_column):
-    delta_times1 = []
-    for i, time in enumerate(time_column):
-        delta_times1.append(time - time_column[i - 1] if i > 0 else 0)
-    delta_times2 = []
-    for i, time in enumerate(time_column):
-        delta_times2.append(time_column[i + 1] - time if i < len(time_column) - 1 else 0)
+        amps = volts / load_ohms
+        # Charge drawn up to each sample, trapezoidal
+        drawn = np.concatenate(([0.0], np.cumsum((amps[1:] + amps[:-1]) / 2 * np.diff(hours))))
 
-    delta_times = [(x + y) / 2 for x, y in zip(delta_times1, delta_times2)]
+        self.capacity_mAh = drawn[-1] * 1000
+        self.energy_Wh = np.trapezoid(volts * amps, hours)
+        self.soc = 1 - drawn / drawn[-1]
 
-    return delta_times
 
-def batteryCapacity(df_time_column, df_power_column):
-    delta_times = midpoint_time_values(df_time_column)
+def battery_type(path):
+    return os.path.basename(path).split("_")[0]
 
-    capacity = 0
-    for d_time, power in zip(delta_times, df_power_column):
-        capacity += power * d_time; 
 
-    return float(capacity)
+def load_log(path, load_ohms):
+    with open(path) as file:
+        header = [name.strip() for name in file.readline().split(",")]
 
-def graph_data_frame(df):
-    x = data_file_columns[0]
+    if TIME_COLUMN not in header or VOLTAGE_COLUMN not in header:
+        raise ValueError(f"{path}: needs '{TIME_COLUMN}' and '{VOLTAGE_COLUMN}' columns")
 
-    fig, ax = plt.subplots()
+    data = np.genfromtxt(path, delimiter=",", skip_header=1,
+                         usecols=(header.index(TIME_COLUMN), header.index(VOLTAGE_COLUMN)))
+    data = data[~np.isnan(data).any(axis=1)]
+    data = data[np.argsort(data[:, 0])]
 
-    for col in df.columns:
-        if col != x:
-            ax.plot(df[x], df[col], label=col, marker='.')
+    return DischargeLog(path, data[:, 0], data[:, 1], load_ohms)
 
-    plt.xlabel(x)
-    ax.yaxis.set_major_locator(ticker.MultipleLocator(0.5))
 
-    ax.grid(True)
+class BatteryFit:
+    def __init__(self, name, logs, degree):
+        self.name = name
+        self.logs = logs
 
-    plt.legend()
-    plt.show()
+        soc = np.concatenate([log.soc for log in logs])
+        volts = np.concatenate([log.volts for log in logs])
+        self.coefficients = np.polyfit(soc, volts, degree)
+        self.rms_mV = np.sqrt(np.mean((np.polyval(self.coefficients, soc) - volts) ** 2)) * 1000
 
-def graph_power_over_voltage(df):
-    x = data_file_columns[1]
+        self.capacity_mAh = np.mean([log.capacity_mAh for log in logs])
 
-    fig, ax = plt.subplots()
+        # The firmware searches the table assuming it only ever rises
+        grid = np.arange(0, 100 + CURVE_STEP, CURVE_STEP) / 100
+        self.curve_mV = np.maximum.accumulate(np.round(np.polyval(self.coefficients, grid) * 1000)).astype(int)
 
-    for col in df.columns:
-        if col not in data_file_columns:
-            ax.plot(df[x], df[col], label=col, marker='.')
+    def volts_at(self, percent):
+        return float(np.interp(percent, np.arange(0, 100 + CURVE_STEP, CURVE_STEP), self.curve_mV)) / 1000
 
-    plt.xlabel(x)
-    plt.ylabel("Power (W)")
-    ax.yaxis.set_major_locator(ticker.MultipleLocator(0.05))
 
-    ax.grid(True)
+def write_header(path, fit, load_ohms):
+    sources = "\n".join(f" *     {os.path.relpath(log.path)}" for log in fit.logs)
+    rows = []
+    for i in range(0, len(fit.curve_mV), 7):
+        rows.append("\t" + ", ".join(str(mV) for mV in fit.curve_mV[i:i + 7]) + ",")
+    thresholds = "\n".join(f"#define {name} {fit.volts_at(percent):.2f}\t// {percent}% charge left"
+                           for name, percent in THRESHOLDS.items())
+
+    text = f"""/**
+ * @file battery_table.h
+ *
+ * @brief Discharge curve and charge thresholds for {fit.name} batteries.
+ *
+ * Generated by src/batteryDataAnalyis.py, run `make battery-table` rather than editing it. Fitted
+ * to the following logs across a {load_ohms} ohm load, {fit.rms_mV:.0f} mV RMS from the measurements:
+{sources}
+ *
+ * batteryCurve holds the battery voltage (mV) at every BATTERY_CURVE_STEP percent state of charge,
+ * from empty to full.
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ */
+
+#ifndef __BATTERY_TABLE_H__
+#define __BATTERY_TABLE_H__
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define BATTERY_CAPACITY_MAH {fit.capacity_mAh:.0f}
+
+{thresholds}
+
+#define BATTERY_CURVE_STEP {CURVE_STEP}
+#define BATTERY_CURVE_POINTS {len(fit.curve_mV)}
 
+static const uint16_t batteryCurve[BATTERY_CURVE_POINTS] PROGMEM = {{
+{chr(10).join(rows)}
+}};
+
+#endif  // __BATTERY_TABLE_H__
+"""
+
+    with open(path, "w") as file:
+        file.write(text)
+
+
+def plot_fits(fits):
+    import matplotlib.pyplot as plt
+
+    fig, ax = plt.subplots()
+    grid = np.linspace(0, 1, 200)
+
+    for fit in fits.values():
+        for log in fit.logs:
+            ax.plot(log.soc * 100, log.volts, '.', label=os.path.basename(log.path))
+        ax.plot(grid * 100, np.polyval(fit.coefficients, grid), label=f"{fit.name} fit")
+
+    plt.xlabel("State of charge (%)")
+    plt.ylabel(VOLTAGE_COLUMN)
+    ax.grid(True)
     plt.legend()
     plt.show()
 
 
-if __name__ == "__main__":
-    df = import_data(data_file, data_file_columns)
+def main():
+    parser = argparse.ArgumentParser(description="Fits battery discharge logs and generates the firmware battery table.")
+    parser.add_argument("logs", nargs="+", help="discharge logs, named <type>_*.csv")
+    parser.add_argument("--load-ohms", type=float, default=DEFAULT_LOAD_OHMS, help="load the logs were taken across")
+    parser.add_argument("--degree", type=int, default=DEFAULT_DEGREE, help="degree of the fitted curve")
+    parser.add_argument("--header", help="write the firmware table header here")
+    parser.add_argument("--type", help="battery type to write the header for, defaults to the first one")
+    parser.add_argument("--plot", action="store_true", help="plot the logs against their fits")
+    args = parser.parse_args()
+
+    groups = {}
+    for path in args.logs:
+        groups.setdefault(battery_type(path), []).append(load_log(path, args.load_ohms))
 
-    for resistance in RESISTANCES:
-        power_df = df['Voltage'].apply(lambda x: power(x, resistance))
+    fits = {name: BatteryFit(name, logs, args.degree) for name, logs in groups.items()}
 
-        df[f"Power {resistance}\u2126 (Wh)"] = power_df
-        battery_capacities[resistance] = batteryCapacity(df[data_file_columns[0]], power_df)
+    print(f"{'log':<32} {'type':>6} {'samples':>8} {'hours':>7} {'mAh':>7} {'Wh':>6}")
+    for fit in fits.values():
+        for log in fit.logs:
+            print(f"{os.path.basename(log.path):<32} {fit.name:>6} {len(log.volts):>8} {log.hours[-1]:>7.2f}"
+                  f" {log.capacity_mAh:>7.0f} {log.energy_Wh:>6.2f}")
 
-    print("Data Set:   ")
-    print(df)
-    
-    save_file = ''
-    while save_file not in ['y', 'n']:
-        save_file = input("Save data? [y,n] ")
+    print()
+    print(f"{'type':<6} {'logs':>5} {'mAh':>7} {'fit mV':>7}  " + "  ".join(f"{name[8:-6]:>7}" for name in THRESHOLDS))
+    for fit in fits.values():
+        print(f"{fit.name:<6} {len(fit.logs):>5} {fit.capacity_mAh:>7.0f} {fit.rms_mV:>7.0f}  "
+              + "  ".join(f"{fit.volts_at(percent):>7.2f}" for percent in THRESHOLDS.values()))
 
-    if save_file == 'y':
-        filename = input("    input filename: ")
-        save_data(df, filename)
+    if args.header:
+        name = args.type or next(iter(fits))
+        if name not in fits:
+            sys.exit(f"no logs for battery type {name}")
+        write_header(args.header, fits[name], args.load_ohms)
+        print(f"\nWrote {name} table to {args.header}")
 
-    print("Graphing data...")
-    # graph_data_frame(df)
-    graph_power_over_voltage(df)
+    if args.plot:
+        plot_fits(fits)
+
+
+if __name__ == "__main__":
+    main()
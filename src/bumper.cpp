@@ -0,0 +1,57 @@
+/**
+ * @file bumper.cpp
+ *
+ * @brief Implementation of the interrupt driven bumper defined in bumper.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "bumper.h"
+#include "params.h"
+
+static volatile uint8_t bumperLatch = DETECTION_FALSE;
+
+static void bumperISR() {
+	// Take both pins off their timers and drive them low
+	pwmWrite<MOTOR_LEFT>(0);
+	pwmWrite<MOTOR_RIGHT>(0);
+
+	bumperLatch = DETECTION_TRUE;
+}
+
+void initBumper() {
+	pinInput<BUMPER_PIN>(true);
+	attachInterrupt(digitalPinToInterrupt(BUMPER_PIN), bumperISR, FALLING);
+}
+
+bool bumperLatched() {
+	return bumperLatch == DETECTION_TRUE;
+}
+
+void updateBumperLatch() {
+	static bool released = false;
+	static unsigned long releasedMs = 0;
+
+	if (bumperLatch != DETECTION_TRUE)
+		return;
+
+	// Hold the latch for as long as the switch is closed
+	if (!pinRead<BUMPER_PIN>()) {
+		released = false;
+		return;
+	}
+
+	// And for a while after, as a bumper that springs back may still be up against whatever it
+	// hit, which the sonar can miss if it's low or narrow
+	if (!released) {
+		released = true;
+		releasedMs = millis();
+	} else if (millis() - releasedMs >= BUMPER_HOLD_MS) {
+		released = false;
+		bumperLatch = DETECTION_FALSE;
+	}
+}
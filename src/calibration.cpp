@@ -0,0 +1,117 @@
+/**
+ * @file calibration.cpp
+ *
+ * @brief Implementation of the EEPROM calibration store defined in calibration.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "calibration.h"
+
+#include <stddef.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
+static_assert(CAL_NUM_PHOTODIODES == NUM_PHOTODIODES, "calibrationStruct needs a baseline for every photodiode");
+static_assert(sizeof(calibrationStruct) <= CAL_SLOT_SIZE, "calibrationStruct outgrew its EEPROM slot");
+static_assert(CAL_EEPROM_BASE + CAL_SLOTS * CAL_SLOT_SIZE <= E2END + 1, "calibration slots don't fit in the EEPROM");
+static_assert(CAL_SLOTS <= 16, "slots are tracked in a 16 bit mask");
+
+calibrationStruct calibration = DEFAULT_CALIBRATION_STRUCT;
+
+static uint8_t currentSlot = CAL_SLOTS - 1;	// the next save goes in the slot after this
+static uint16_t newestSequence = 0;
+static unsigned long lastSaveMs = 0;
+
+static uint8_t* slotAddress(uint8_t slot) {
+	return (uint8_t*) (uintptr_t) (CAL_EEPROM_BASE + (uint16_t) slot * CAL_SLOT_SIZE);
+}
+
+static uint16_t calibrationCrc(const calibrationStruct* record) {
+	const uint8_t* bytes = (const uint8_t*) record;
+	uint16_t crc = 0xFFFF;
+
+	for (uint8_t i = 0; i < offsetof(calibrationStruct, crc); i++)
+		crc = _crc_ccitt_update(crc, bytes[i]);
+	return crc;
+}
+
+static bool calibrationValid(const calibrationStruct* record) {
+	if (record->version != CAL_VERSION || record->crc != calibrationCrc(record))
+		return false;
+
+	// Passing the CRC doesn't make the values sane
+	return record->servoMin < record->servoMax && record->servoMax <= 180
+		&& record->servoStart >= record->servoMin && record->servoStart <= record->servoMax
+		&& record->motorBalance >= -MOTOR_MAX_BALANCE && record->motorBalance <= MOTOR_MAX_BALANCE;
+}
+
+bool loadCalibration() {
+	uint16_t sequences[CAL_SLOTS];
+	uint16_t candidates = 0;
+	calibrationStruct record;
+
+	currentSlot = CAL_SLOTS - 1;
+	newestSequence = 0;
+	lastSaveMs = millis();
+
+	// Headers only, an erased slot reads back 0xFF
+	for (uint8_t slot = 0; slot < CAL_SLOTS; slot++) {
+		uint8_t* address = slotAddress(slot);
+		if (eeprom_read_byte(address + offsetof(calibrationStruct, version)) != CAL_VERSION)
+			continue;
+
+		sequences[slot] = eeprom_read_word((const uint16_t*) (address + offsetof(calibrationStruct, sequence)));
+		// Number on from the newest one written, even if it turns out to be corrupt
+		if (!candidates || (int16_t) (sequences[slot] - newestSequence) > 0)
+			newestSequence = sequences[slot];
+		candidates |= (uint16_t) 1 << slot;
+	}
+
+	while (candidates) {
+		int8_t newest = -1;
+		for (uint8_t slot = 0; slot < CAL_SLOTS; slot++) {
+			if (!(candidates & ((uint16_t) 1 << slot)))
+				continue;
+			if (newest < 0 || (int16_t) (sequences[slot] - sequences[newest]) > 0)
+				newest = slot;
+		}
+
+		eeprom_read_block(&record, slotAddress(newest), sizeof(record));
+		if (calibrationValid(&record)) {
+			calibration = record;
+			currentSlot = newest;
+			return true;
+		}
+		candidates &= ~((uint16_t) 1 << newest);
+	}
+
+	calibration = DEFAULT_CALIBRATION_STRUCT;
+	return false;
+}
+
+void saveCalibration() {
+	currentSlot = (currentSlot + 1) % CAL_SLOTS;
+
+	calibration.version = CAL_VERSION;
+	calibration.sequence = ++newestSequence;
+	calibration.crc = calibrationCrc(&calibration);
+
+	// A power loss part way through only spoils this slot, the previous one is still there
+	eeprom_update_block(&calibration, slotAddress(currentSlot), sizeof(calibration));
+	lastSaveMs = millis();
+}
+
+void saveServoRest(int angle) {
+	if (abs(angle - calibration.servoStart) < CAL_SERVO_SAVE_DEG)
+		return;
+	if (millis() - lastSaveMs < CAL_SAVE_INTERVAL_MS)
+		return;
+
+	calibration.servoStart = angle;
+	saveCalibration();
+}
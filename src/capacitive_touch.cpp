@@ -10,6 +10,8 @@
 
 #include "capacitive_touch.h"
 
+#if FEATURE_CAP_TOUCH
+
 long computeTau() {
 	static CapacitiveSensor sensor = CapacitiveSensor(CAP_OUT_PIN, CAP_IN_PIN);
 	long tau = sensor.capacitiveSensor(CAP_SENSOR_SAMPLES);
@@ -20,7 +22,9 @@ long computeTau() {
 bool detectCapTouch() {
 	long tau = computeTau();
 
-	if (tau > CAP_SENSOR_TAU_THRESHOLD) 
+	if (tau > calibration.capThreshold)
 		return true;
 	return false;
 }
+
+#endif  // FEATURE_CAP_TOUCH
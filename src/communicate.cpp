@@ -13,19 +13,30 @@
 #include "communicate.h"
 #include "includes.h"
 
-void println(char* msg) {
+extern float batteryVoltage;
+
+void println(const char* msg) {
 	Serial.println(msg);
 }
 
-void print(char* msg) {
+void print(const char* msg) {
 	Serial.print(msg);
 }
 
-void debug(char* msg) {
+void debug(const char* msg) {
 	print("DEBUG: ");
 	print(msg);
 }
 
+struct dataBlob* allocateDataBlob() {
+	struct dataBlob* blob = (struct dataBlob*) BLOB_MALLOC(sizeof(struct dataBlob));
+
+	// free() lowers the heap top again straight after the frame is sent
+	noteHeapTop();
+
+	return blob;
+}
+
 void initializeBlob(struct dataBlob* blob, uint8_t header) {
 	blob->dataBlob = 0;
 	blob->dataUsed = 0;
@@ -56,6 +67,62 @@ struct dataBlob* newPinDataBlob() {
 	return outBlob;
 }
 
+struct dataBlob* newMemoryDataBlob() {
+	struct dataBlob* outBlob = NEW_DATA_BLOB();
+
+	initializeBlob(outBlob, MEMORY_DATA_BLOB_HEADER);
+
+	return outBlob;
+}
+
+struct dataBlob* newBatteryDataBlob() {
+	struct dataBlob* outBlob = NEW_DATA_BLOB();
+
+	initializeBlob(outBlob, BATTERY_DATA_BLOB_HEADER);
+
+	return outBlob;
+}
+
+struct dataBlob* newProfilerDataBlob() {
+	struct dataBlob* outBlob = NEW_DATA_BLOB();
+
+	initializeBlob(outBlob, PROFILER_DATA_BLOB_HEADER);
+
+	return outBlob;
+}
+
+struct dataBlob* newPinSummaryDataBlob() {
+	struct dataBlob* outBlob = NEW_DATA_BLOB();
+
+	initializeBlob(outBlob, PIN_SUMMARY_DATA_BLOB_HEADER);
+
+	return outBlob;
+}
+
+struct dataBlob* newPinHistogramDataBlob() {
+	struct dataBlob* outBlob = NEW_DATA_BLOB();
+
+	initializeBlob(outBlob, PIN_HISTOGRAM_DATA_BLOB_HEADER);
+
+	return outBlob;
+}
+
+struct dataBlob* newDeadlineDataBlob() {
+	struct dataBlob* outBlob = NEW_DATA_BLOB();
+
+	initializeBlob(outBlob, DEADLINE_DATA_BLOB_HEADER);
+
+	return outBlob;
+}
+
+struct dataBlob* newDeadlineResetDataBlob() {
+	struct dataBlob* outBlob = NEW_DATA_BLOB();
+
+	initializeBlob(outBlob, DEADLINE_RESET_DATA_BLOB_HEADER);
+
+	return outBlob;
+}
+
 COMM_STATUS dataMarshall_uint8(struct dataBlob* dataBlob, uint8_t data) {
 	// Check to see if the blob has room
 	if (dataBlob->dataUsed >= DATA_BLOB_DATA_SIZE) {
@@ -87,6 +154,19 @@ COMM_STATUS dataMarshall_uint16(struct dataBlob* dataBlob, uint16_t data) {
 	return status;
 }
 
+COMM_STATUS dataMarshall_uint32(struct dataBlob* dataBlob, uint32_t data) {
+	COMM_STATUS status;
+
+	status = dataMarshall_uint16(dataBlob, (uint16_t)data);
+	// If something went wrong, just bail
+	if (status != COMM_STATUS_OK) {
+		return status;
+	}
+	status = dataMarshall_uint16(dataBlob, (uint16_t) (data >> 16));
+
+	return status;
+}
+
 COMM_STATUS dataMarshall_float(struct dataBlob* dataBlob, float value) {
     uint8_t* bytes = (uint8_t*)&value;
 
@@ -107,6 +187,8 @@ COMM_STATUS sendMarshalledData(struct dataBlob* dataBlob) {
 		uint8_t payload = dataBlob->dataBlob >> (i * 8);
 		Serial.write(payload);
 	}
+
+	return COMM_STATUS_OK;
 }
 
 
@@ -127,10 +209,10 @@ COMM_STATUS sendPinData(uint8_t pin, float data) {
 	dataMarshall_uint8(dataBlob, pin);
 	dataMarshall_float(dataBlob, data);
 
-	sendMarshalledData(dataBlob);
+	COMM_STATUS status = sendMarshalledData(dataBlob);
 
-	free(dataBlob);
-	
+	FREE_DATA_BLOB(dataBlob);
+	return status;
 }
 
 void printRobotData(detectionDataStruct* data) {
@@ -142,7 +224,7 @@ void printRobotData(detectionDataStruct* data) {
 
 	sendMarshalledData(dataBlob);
 
-	free(dataBlob);
+	FREE_DATA_BLOB(dataBlob);
 }
 
 
@@ -155,10 +237,64 @@ void printRobotActions(actionStateStruct* actions) {
 
 	sendMarshalledData(actionBlob);
 
-	free(actionBlob);
+	FREE_DATA_BLOB(actionBlob);
 }
 
 void printRobotState(detectionDataStruct* data, actionStateStruct* actions) {
 	printRobotData(data);
 	printRobotActions(actions);
 }
+
+void printMemoryState(memoryStatsStruct* stats) {
+	struct dataBlob* memoryBlob = newMemoryDataBlob();
+
+	dataMarshall_uint16(memoryBlob, stats->freeNow);
+	dataMarshall_uint16(memoryBlob, stats->minMargin);
+	dataMarshall_uint16(memoryBlob, stats->heapTop);
+	dataMarshall_uint8(memoryBlob, stats->status);
+
+	sendMarshalledData(memoryBlob);
+
+	FREE_DATA_BLOB(memoryBlob);
+}
+
+void printBatteryState(uint8_t power) {
+	struct dataBlob* batteryBlob = newBatteryDataBlob();
+
+	dataMarshall_uint16(batteryBlob, batteryVoltage * 1000);
+	dataMarshall_uint16(batteryBlob, batteryRuntimeMinutes());
+	dataMarshall_uint16(batteryBlob, batteryCompensation());
+	dataMarshall_uint8(batteryBlob, power);
+
+	sendMarshalledData(batteryBlob);
+
+	FREE_DATA_BLOB(batteryBlob);
+}
+
+void printDeadlineState() {
+	for (uint8_t phase = 0; phase < NUM_PHASES; phase++) {
+		struct dataBlob* deadlineBlob = newDeadlineDataBlob();
+
+		dataMarshall_uint8(deadlineBlob, phase);
+		dataMarshall_uint16(deadlineBlob, phaseStats[phase].overruns);
+		dataMarshall_uint32(deadlineBlob, phaseStats[phase].windowMaxUs);
+
+		sendMarshalledData(deadlineBlob);
+
+		FREE_DATA_BLOB(deadlineBlob);
+		phaseStats[phase].windowMaxUs = 0;
+	}
+}
+
+void printDeadlineReset(deadlineRecordStruct* record) {
+	struct dataBlob* resetBlob = newDeadlineResetDataBlob();
+
+	dataMarshall_uint8(resetBlob, record->phase);
+	dataMarshall_uint32(resetBlob, record->atMs);
+	dataMarshall_uint16(resetBlob, record->phaseMs);
+	dataMarshall_uint8(resetBlob, record->resets);
+
+	sendMarshalledData(resetBlob);
+
+	FREE_DATA_BLOB(resetBlob);
+}
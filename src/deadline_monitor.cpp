@@ -0,0 +1,185 @@
+/**
+ * @file deadline_monitor.cpp
+ *
+ * @brief Implementation of the loop deadline monitor defined in deadline_monitor.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include <avr/interrupt.h>
+
+#include "includes.h"
+#include "deadline_monitor.h"
+
+// Indexed by DEADLINE_PHASE
+extern constexpr uint32_t phaseBudgetUs[NUM_PHASES] = {DEADLINE_BUDGET_US};
+
+// The watchdog oscillator times out after 16 ms << WDTO_
+constexpr uint32_t watchdogTimeoutUs(uint8_t timeout) {
+	return 16000UL << timeout;
+}
+
+constexpr bool budgetsSet(unsigned int i = 0) {
+	return i >= NUM_PHASES || (phaseBudgetUs[i] > 0 && budgetsSet(i + 1));
+}
+
+constexpr uint32_t budgetsTotal(unsigned int i = 0) {
+	return (i >= NUM_PHASES) ? 0 : phaseBudgetUs[i] + budgetsTotal(i + 1);
+}
+
+static_assert(budgetsSet(), "DEADLINE_BUDGET_US needs a budget for every phase");
+static_assert(budgetsTotal() < watchdogTimeoutUs(DEADLINE_WATCHDOG_TIMEOUT),
+		"A pass of loop() within DEADLINE_BUDGET_US has to kick the watchdog before it times out");
+
+phaseStatsStruct phaseStats[NUM_PHASES];
+
+// Left alone by the C runtime, so it still holds what the watchdog interrupt wrote after the reset
+deadlineRecordStruct deadlineRecord __attribute__ ((section(".noinit")));
+
+// Read by the watchdog interrupt
+static volatile uint8_t runningPhase = DEADLINE_PHASE_NONE;
+static volatile uint32_t phaseStartUs = 0;
+static volatile uint8_t overrunPhase = DEADLINE_PHASE_NONE;
+static volatile uint16_t overrunMs = 0;
+
+// Set by the watchdog interrupt. Unlike deadlineRecord it starts over on every boot.
+static volatile bool wheelsStopped = false;
+
+static bool passOverran = false;
+
+static deadlineRecordStruct lastReset;
+static bool resetPending = false;
+
+#if defined(__AVR__)
+/*
+ * A watchdog reset leaves the watchdog running at its shortest timeout, far too short for
+ * setup(). Turn it off before the C runtime, clearing WDRF first as it would only turn back on.
+ */
+void disableWatchdog() __attribute__ ((naked, used, section(".init3")));
+void disableWatchdog() {
+	MCUSR = 0;
+	wdt_disable();
+}
+#endif
+
+static uint16_t toMs(uint32_t us) {
+	return (us / 1000 > 0xFFFF) ? 0xFFFF : us / 1000;
+}
+
+ISR(WDT_vect) {
+	// Take both pins off their timers and drive them low, like the bumper
+	pwmWrite<MOTOR_LEFT>(0);
+	pwmWrite<MOTOR_RIGHT>(0);
+	wheelsStopped = true;
+
+	// Blame the phase still running if it's over budget, otherwise the last one that was
+	uint8_t phase = runningPhase;
+	uint32_t runUs = micros() - phaseStartUs;
+	if (phase != DEADLINE_PHASE_NONE && runUs > phaseBudgetUs[phase]) {
+		deadlineRecord.phase = phase;
+		deadlineRecord.phaseMs = toMs(runUs);
+	} else if (overrunPhase != DEADLINE_PHASE_NONE) {
+		deadlineRecord.phase = overrunPhase;
+		deadlineRecord.phaseMs = overrunMs;
+	} else {
+		deadlineRecord.phase = DEADLINE_PHASE_OUTSIDE;
+		deadlineRecord.phaseMs = 0;
+	}
+	deadlineRecord.atMs = millis();
+
+	// WDIE is cleared on the way in, the next timeout resets
+}
+
+void initDeadlineMonitor() {
+	// Whatever was in RAM at power on
+	if (deadlineRecord.magic != DEADLINE_MAGIC
+			|| (deadlineRecord.phase > DEADLINE_PHASE_OUTSIDE && deadlineRecord.phase != DEADLINE_PHASE_NONE)) {
+		deadlineRecord.magic = DEADLINE_MAGIC;
+		deadlineRecord.phase = DEADLINE_PHASE_NONE;
+		deadlineRecord.resets = 0;
+		deadlineRecord.atMs = 0;
+		deadlineRecord.phaseMs = 0;
+	}
+
+	resetPending = deadlineRecord.phase != DEADLINE_PHASE_NONE;
+	if (resetPending) {
+		if (deadlineRecord.resets < 0xFF)
+			deadlineRecord.resets++;
+		lastReset = deadlineRecord;
+		deadlineRecord.phase = DEADLINE_PHASE_NONE;
+	}
+
+	memset(phaseStats, 0, sizeof(phaseStats));
+	runningPhase = DEADLINE_PHASE_NONE;
+	overrunPhase = DEADLINE_PHASE_NONE;
+	passOverran = false;
+	wheelsStopped = false;
+
+#ifndef DEADLINE_NO_WATCHDOG
+	wdt_enable(DEADLINE_WATCHDOG_TIMEOUT);
+	// Interrupt first, then reset. WDIE doesn't need the timed sequence WDE does.
+	WDTCSR |= _BV(WDIE);
+#endif
+}
+
+static void endPhase() {
+	if (runningPhase == DEADLINE_PHASE_NONE)
+		return;
+
+	uint32_t us = micros() - phaseStartUs;
+	phaseStatsStruct* stats = &phaseStats[runningPhase];
+
+	stats->runs++;
+	stats->lastUs = us;
+	if (us > stats->maxUs)
+		stats->maxUs = us;
+	if (us > stats->windowMaxUs)
+		stats->windowMaxUs = us;
+
+	if (us > phaseBudgetUs[runningPhase]) {
+		if (stats->overruns < 0xFFFF)
+			stats->overruns++;
+		passOverran = true;
+		overrunMs = toMs(us);
+		overrunPhase = runningPhase;
+	}
+
+	runningPhase = DEADLINE_PHASE_NONE;
+}
+
+void beginPhase(uint8_t phase) {
+	endPhase();
+
+	phaseStartUs = micros();
+	runningPhase = phase;
+}
+
+void endLoop() {
+	endPhase();
+
+	// Once the interrupt has stopped the wheels, leave the reset to follow
+	if (!passOverran && !deadlineStopped()) {
+#ifndef DEADLINE_NO_WATCHDOG
+		wdt_reset();
+#endif
+		overrunPhase = DEADLINE_PHASE_NONE;
+	}
+	passOverran = false;
+}
+
+bool deadlineStopped() {
+	return wheelsStopped;
+}
+
+bool takeDeadlineReset(deadlineRecordStruct* record) {
+	if (!resetPending)
+		return false;
+
+	*record = lastReset;
+	resetPending = false;
+	return true;
+}
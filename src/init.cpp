@@ -15,41 +15,50 @@
 #include "capacitive_touch.h"
 #include "params.h"
 
+#if FEATURE_SERVO
 Servo servo;
 int servoAngle;
+#endif
 
 NewPing sonarSensor(ULTRASONIC_TRIGGER_PIN, ULTRASONIC_ECHO_PIN, ULTRASONIC_MAX_DIST);
 
 void initPins() {
-	// Input pins
-	pinMode(BUTTON_COLLISION, INPUT);
+	// Input pins. BUTTON_COLLISION (A6) is analog only and always an input.
+	initBumper();
 
-	pinMode(MOTOR_LEFT, OUTPUT);
-	pinMode(MOTOR_RIGHT, OUTPUT);
+	pinOutput<MOTOR_LEFT>();
+	pinOutput<MOTOR_RIGHT>();
+	initMotors();
 
-	pinMode(LED_COLLISION, OUTPUT);
-	pinMode(LED_BUILTIN, OUTPUT);
+	pinOutput<LED_COLLISION>();
+	pinOutput<LED_BUILTIN>();
 
-	pinMode(CAP_OUT_PIN, OUTPUT);
-	pinMode(CAP_IN_PIN, INPUT);
+#if FEATURE_CAP_TOUCH
+	pinOutput<CAP_OUT_PIN>();
+	pinInput<CAP_IN_PIN>(false);
+#endif
 
-	pinMode(PHOTODIODE_TOP_LEFT, INPUT);
-	pinMode(PHOTODIODE_BOTTOM_LEFT, INPUT);
-	pinMode(PHOTODIODE_BOTTOM_RIGHT, INPUT);
-	pinMode(PHOTODIODE_TOP_RIGHT, INPUT);
+	pinInput<PHOTODIODE_TOP_LEFT>(false);
+	pinInput<PHOTODIODE_BOTTOM_LEFT>(false);
+	pinInput<PHOTODIODE_BOTTOM_RIGHT>(false);
+	pinInput<PHOTODIODE_TOP_RIGHT>(false);
 
-	// pinMode(ULTRASONIC_TRIGGER_PIN, OUTPUT);
-	// pinMode(ULTRASONIC_ECHO_PIN, INPUT);
+	// NewPing sets up ULTRASONIC_TRIGGER_PIN and ULTRASONIC_ECHO_PIN itself
 }
 
 void initSerialComm() {
+#if FEATURE_TELEMETRY
 	// Primary serial port
 	Serial.begin(9600);  
+#endif
 }
 
 void initServo() {
+#if FEATURE_SERVO
 	servo.attach(SERVO_PIN);
-	servo.write(SERVO_ANGLE_START);
+	servo.write(calibration.servoStart);
 
-	servoAngle = SERVO_ANGLE_START;
+	servoAngle = calibration.servoStart;
+	initServoPlanner(calibration.servoStart);
+#endif
 }
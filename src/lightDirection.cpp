@@ -11,32 +11,49 @@
 
 #include "lightDirection.h"
 
-bool isLight(int pin) {
-	float voltage = readPinVoltage(pin);
+float photodiodeVoltages[NUM_PHOTODIODES];
 
-	return voltage >= PHOTODIODE_VOLTAGE_LIMIT;
+// Indexed by PHOTODIODE, see oversample.h
+static constexpr uint8_t photodiodeExtraBits[] = {PHOTODIODE_EXTRA_BITS};
+
+constexpr bool extraBitsInRange(unsigned int i = 0) {
+	return i >= NUM_PHOTODIODES
+			|| (photodiodeExtraBits[i] <= OVERSAMPLE_MAX_EXTRA_BITS && extraBitsInRange(i + 1));
+}
+
+static_assert(sizeof(photodiodeExtraBits) == NUM_PHOTODIODES, "PHOTODIODE_EXTRA_BITS needs one count per photodiode");
+static_assert(extraBitsInRange(), "PHOTODIODE_EXTRA_BITS past OVERSAMPLE_MAX_EXTRA_BITS");
+
+static bool readPhotodiode(PHOTODIODE diode, uint8_t pin) {
+	photodiodeVoltages[diode] = readOversampledVoltage(pin, photodiodeExtraBits[diode])
+			- calibration.photodiodeBaseline[diode] * 0.001;
+
+	return photodiodeVoltages[diode] >= PHOTODIODE_VOLTAGE_LIMIT;
 }
 
 LIGHT_DIR detectLightDirection() {
-	bool lightTopLeft = isLight(PHOTODIODE_TOP_LEFT);
-	bool lightBotLeft = isLight(PHOTODIODE_BOTTOM_LEFT);
-	bool lightBotRight = isLight(PHOTODIODE_BOTTOM_RIGHT);
-	bool lightTopRight = isLight(PHOTODIODE_VOLTAGE_LIMIT);
-
-	LIGHT_DIR dir = 0x0;
-
-	// light detected up
-	if (lightTopLeft && lightTopRight)
-		dir |= LIGHT_UP;
-	// light detected down
-	if (lightBotLeft && lightBotRight)
-		dir |= LIGHT_DOWN;
-	// Light detected left
-	if (lightTopLeft && lightBotLeft)
-		dir |= LIGHT_LEFT;
-	// Light detected right
-	if (lightTopRight && lightBotRight)
-		dir |= LIGHT_RIGHT;
-
-	return dir;
+	uint8_t mask = (readPhotodiode(PD_TOP_LEFT, PHOTODIODE_TOP_LEFT) << PD_TOP_LEFT)
+			| (readPhotodiode(PD_BOTTOM_LEFT, PHOTODIODE_BOTTOM_LEFT) << PD_BOTTOM_LEFT)
+			| (readPhotodiode(PD_BOTTOM_RIGHT, PHOTODIODE_BOTTOM_RIGHT) << PD_BOTTOM_RIGHT)
+			| (readPhotodiode(PD_TOP_RIGHT, PHOTODIODE_TOP_RIGHT) << PD_TOP_RIGHT);
+
+	return lightPatternDirection(mask);
+}
+
+float lightVerticalBalance() {
+	float top = photodiodeVoltages[PD_TOP_LEFT] + photodiodeVoltages[PD_TOP_RIGHT];
+	float bottom = photodiodeVoltages[PD_BOTTOM_LEFT] + photodiodeVoltages[PD_BOTTOM_RIGHT];
+
+	if (top + bottom <= 0)
+		return 0;
+	return (top - bottom) / (top + bottom);
+}
+
+float lightHorizontalBalance() {
+	float left = photodiodeVoltages[PD_TOP_LEFT] + photodiodeVoltages[PD_BOTTOM_LEFT];
+	float right = photodiodeVoltages[PD_TOP_RIGHT] + photodiodeVoltages[PD_BOTTOM_RIGHT];
+
+	if (left + right <= 0)
+		return 0;
+	return (left - right) / (left + right);
 }
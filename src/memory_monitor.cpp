@@ -0,0 +1,142 @@
+/**
+ * @file memory_monitor.cpp
+ *
+ * @brief Implementation of the SRAM monitor defined in memory_monitor.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "includes.h"
+#include "memory_monitor.h"
+
+memoryStatsStruct memoryStats = {
+	.freeNow = 0,
+	.minMargin = 0xFFFF,
+	.heapTop = 0,
+	.status = MEMORY_OK,
+};
+
+#if defined(__AVR__)
+
+extern uint8_t __heap_start;
+extern void* __brkval;
+
+/*
+ * Paints everything between the end of .bss and the top of RAM with the canary.
+ * Runs in .init1, before the stack pointer is set up, so it must not touch the stack.
+ */
+void paintStack() __attribute__ ((naked, used, section(".init1")));
+void paintStack() {
+	__asm volatile (
+		"    ldi r30, lo8(_end)     \n"
+		"    ldi r31, hi8(_end)     \n"
+		"    ldi r24, %0            \n"
+		"    ldi r25, hi8(__stack)  \n"
+		"    rjmp 2f                \n"
+		"1:  st Z+, r24             \n"
+		"2:  cpi r30, lo8(__stack)  \n"
+		"    cpc r31, r25           \n"
+		"    brlo 1b                \n"
+		"    breq 1b                \n"
+		:: "M" (MEMORY_CANARY)
+	);
+}
+
+static uint8_t* heapStart() {
+	return &__heap_start;
+}
+
+static uint8_t* heapBreak() {
+	return (uint8_t*) __brkval;
+}
+
+static uint8_t* stackPointer() {
+	return (uint8_t*) SP;
+}
+
+static uint16_t ramAddress(uint8_t* p) {
+	return (uint16_t) (uintptr_t) p;
+}
+
+#else
+
+// The shim's model of the ATmega328P's RAM and avr-libc's heap, see sim_hardware.h
+
+// Stands in for the .init1 paint above, simReset() runs it
+extern "C" void simInit1() {
+	for (uint16_t address = SIM_HEAP_START; address <= SIM_RAMEND; address++)
+		*simRamAt(address) = MEMORY_CANARY;
+}
+
+static uint8_t* heapStart() {
+	return simRamAt(SIM_HEAP_START);
+}
+
+static uint8_t* heapBreak() {
+	return sim.heapBreak ? simRamAt(sim.heapBreak) : 0;
+}
+
+static uint8_t* stackPointer() {
+	return simRamAt(SP);
+}
+
+static uint16_t ramAddress(uint8_t* p) {
+	return SIM_RAM_START + (uint16_t) (p - sim.ram);
+}
+
+#endif
+
+static uint8_t* heapTop() {
+	return (heapBreak() == 0) ? heapStart() : heapBreak();
+}
+
+// Highest the heap top has been seen, see noteHeapTop()
+static uint8_t* heapPeak = 0;
+
+void noteHeapTop() {
+	uint8_t* top = heapTop();
+
+	if (top > heapPeak)
+		heapPeak = top;
+}
+
+uint16_t freeMemory() {
+	return (uint16_t) (stackPointer() - heapTop());
+}
+
+static uint16_t stackMargin() {
+	noteHeapTop();
+	uint8_t* p = heapPeak;
+	uint8_t* sp = stackPointer();
+
+	// The first non-canary byte above the heap is the deepest the stack has reached
+	while (p < sp && *p == MEMORY_CANARY)
+		p++;
+
+	return (uint16_t) (p - heapPeak);
+}
+
+MEMORY_STATUS updateMemoryMonitor() {
+	static unsigned long lastCheck = 0;
+
+	if (memoryStats.minMargin != 0xFFFF && millis() - lastCheck < MEMORY_CHECK_INTERVAL)
+		return memoryStats.status;
+	lastCheck = millis();
+
+	memoryStats.freeNow = freeMemory();
+	memoryStats.heapTop = ramAddress(heapTop());
+
+	uint16_t margin = stackMargin();
+	if (margin < memoryStats.minMargin)
+		memoryStats.minMargin = margin;
+
+	// Once low, stay low. The painted region never recovers, so neither should we.
+	if (memoryStats.minMargin < MEMORY_MARGIN_THRESHOLD)
+		memoryStats.status = MEMORY_LOW;
+
+	return memoryStats.status;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file motor.cpp
+ *
+ * @brief Implementation of the drive motor layer defined in motor.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "motor.h"
+#include "params.h"
+
+motorStruct motors[NUM_MOTORS] = {
+	{MOTOR_LEFT, 0, 0, 255, 0},
+	{MOTOR_RIGHT, 0, 0, 255, 0},
+};
+
+static int balance = 0;
+static uint16_t supplyScale = 256;
+static unsigned long lastRampUs = 0;
+
+// The bumper, or the watchdog interrupt after a pass overran, has stopped the wheels
+static bool motorsCut() {
+	return bumperLatched() || deadlineStopped();
+}
+
+static void writeMotor(motorStruct* motor, uint8_t pwm) {
+	// The bumper or the watchdog may have cut the motors since planning ran. Check and write
+	// with interrupts off so their ISRs can't land in between and get undone.
+	noInterrupts();
+	if (motorsCut())
+		pwm = LOW;
+	if (motor->pin == MOTOR_LEFT)
+		pwmWrite<MOTOR_LEFT>(pwm);
+	else
+		pwmWrite<MOTOR_RIGHT>(pwm);
+	interrupts();
+
+	motor->written = pwm;
+}
+
+/*
+ * Timer2 at MOTOR_PWM_HZ, counting to 255. The outputs are left off the timer until
+ * pwmWrite() gives them a duty.
+ */
+static void initMotorPwm() {
+#ifdef MOTOR_PWM_FAST
+	TCCR2A = _BV(WGM21) | _BV(WGM20);
+#else
+	TCCR2A = _BV(WGM20);
+#endif
+	TCCR2B = motorPwmClockSelect(MOTOR_PWM_PRESCALER);
+}
+
+void initMotors() {
+	initMotorPwm();
+	setMotorBalance(calibration.motorBalance);
+
+	for (int i = 0; i < NUM_MOTORS; i++) {
+		motors[i].target = 0;
+		motors[i].output = 0;
+		writeMotor(&motors[i], LOW);
+	}
+	lastRampUs = micros();
+}
+
+void setMotorSpeed(MOTOR_ID motor, uint8_t speed) {
+	motors[motor].target = speed;
+}
+
+/*
+ * How far the outputs may climb since the last step, in PWM counts.
+ */
+static uint8_t rampStep() {
+#ifdef MOTOR_NO_RAMP
+	return 255;
+#else
+	unsigned long now = micros();
+	unsigned long elapsed = now - lastRampUs;
+
+	if (elapsed >= MOTOR_RAMP_MS * 1000UL) {
+		lastRampUs = now;
+		return 255;
+	}
+
+	uint8_t step = (uint32_t) elapsed * 255 / (MOTOR_RAMP_MS * 1000UL);
+	// Keep the remainder for next time, so a fast loop still ramps at the full rate
+	lastRampUs += (uint32_t) step * MOTOR_RAMP_MS * 1000UL / 255;
+	return step;
+#endif
+}
+
+void updateMotors() {
+	bool ramping = false;
+	for (int i = 0; i < NUM_MOTORS; i++) {
+		if (motors[i].output < motors[i].target)
+			ramping = true;
+	}
+
+	uint8_t step = 0;
+	if (ramping) {
+		step = rampStep();
+	} else {
+		lastRampUs = micros();
+	}
+
+	for (int i = 0; i < NUM_MOTORS; i++) {
+		motorStruct* motor = &motors[i];
+
+		// The bumper cut this wheel, start over from standstill once it lets go
+		if (motorsCut())
+			motor->output = 0;
+
+		if (motor->output >= motor->target) {
+			motor->output = motor->target;
+		} else if (motor->output < MOTOR_RAMP_START) {
+			// Below here the wheel doesn't turn and barely draws anything
+			motor->output = (motor->target < MOTOR_RAMP_START) ? motor->target : MOTOR_RAMP_START;
+		} else if (motor->target - motor->output <= step) {
+			motor->output = motor->target;
+		} else {
+			motor->output += step;
+		}
+
+		uint32_t pwm = (uint32_t) motor->output * motor->trim / 255 * supplyScale / 256;
+		if (pwm > 255)
+			pwm = 255;
+		if (pwm != motor->written || motorsCut())
+			writeMotor(motor, pwm);
+	}
+}
+
+void setMotorSupplyScale(uint16_t scale) {
+	supplyScale = scale;
+}
+
+void setMotorBalance(int newBalance) {
+	if (newBalance > MOTOR_MAX_BALANCE)
+		newBalance = MOTOR_MAX_BALANCE;
+	if (newBalance < -MOTOR_MAX_BALANCE)
+		newBalance = -MOTOR_MAX_BALANCE;
+	balance = newBalance;
+
+	// Only ever slow the stronger wheel down
+	motors[MOTOR_ID_LEFT].trim = (balance < 0) ? 255 + balance : 255;
+	motors[MOTOR_ID_RIGHT].trim = (balance > 0) ? 255 - balance : 255;
+}
+
+int motorBalance() {
+	return balance;
+}
+
+/*
+ * Drives straight for one calibration burst and then waits for the robot to stop.
+ */
+static void calibrationBurst() {
+	unsigned long start = millis();
+
+	setMotorSpeed(MOTOR_ID_LEFT, MOTOR_CAL_SPEED);
+	setMotorSpeed(MOTOR_ID_RIGHT, MOTOR_CAL_SPEED);
+	while (millis() - start < MOTOR_CAL_DRIVE_MS && !bumperLatched()) {
+		updateMotors();
+		delay(1);
+	}
+
+	setMotorSpeed(MOTOR_ID_LEFT, 0);
+	setMotorSpeed(MOTOR_ID_RIGHT, 0);
+	updateMotors();
+	delay(MOTOR_CAL_SETTLE_MS);
+}
+
+int calibrateMotorTrim() {
+	int step = MOTOR_CAL_MAX_STEP;
+	int lastDirection = 0;
+
+	setMotorBalance(0);
+
+	for (int pass = 0; pass < MOTOR_CAL_PASSES; pass++) {
+		detectLightDirection();
+		float before = lightHorizontalBalance();
+
+		calibrationBurst();
+		if (bumperLatched())
+			break;
+
+		detectLightDirection();
+		float drift = lightHorizontalBalance() - before;
+		if (fabs(drift) < MOTOR_CAL_TOLERANCE)
+			break;
+
+		// Light moving left means the robot turned right, so the left wheel is the stronger one
+		int direction = (drift > 0) ? -1 : 1;
+		if (lastDirection != 0 && direction != lastDirection && step > 1)
+			step /= 2;
+		lastDirection = direction;
+
+		setMotorBalance(balance + direction * step);
+	}
+
+	return balance;
+}
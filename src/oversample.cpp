@@ -0,0 +1,69 @@
+/**
+ * @file oversample.cpp
+ *
+ * @brief Implementation of the oversampled ADC reads defined in oversample.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "oversample.h"
+
+#ifdef ADC_NOISE_SLEEP
+#include <avr/sleep.h>
+
+// Only there to wake the CPU, the result is read afterwards
+EMPTY_INTERRUPT(ADC_vect);
+
+static uint16_t convert(uint8_t pin) {
+	// Takes A0..A7 or channel numbers, like analogRead()
+	if (pin >= A0)
+		pin -= A0;
+	ADMUX = _BV(REFS0) | (pin & 0x07);
+
+	set_sleep_mode(SLEEP_MODE_ADC);
+	ADCSRA |= _BV(ADIE) | _BV(ADSC);
+
+	// Another interrupt can wake it before the conversion is done
+	while (true) {
+		// Interrupts stay off until the instruction after sei(), so the ADC one can't slip in
+		// between the check and going to sleep
+		noInterrupts();
+		if (!(ADCSRA & _BV(ADSC))) {
+			interrupts();
+			break;
+		}
+		sleep_enable();
+		interrupts();
+		sleep_cpu();
+		sleep_disable();
+	}
+
+	ADCSRA &= ~_BV(ADIE);
+	return ADC;
+}
+#else
+static uint16_t convert(uint8_t pin) {
+	return analogRead(pin);
+}
+#endif
+
+uint16_t readOversampledCounts(uint8_t pin, uint8_t extraBits) {
+	uint16_t sum = 0;
+
+	for (uint8_t i = 0; i < (1 << (2 * extraBits)); i++)
+		sum += convert(pin);
+	sum >>= extraBits;
+
+	aggregatePinSample(pin, sum >> extraBits);
+	return sum;
+}
+
+float readOversampledVoltage(uint8_t pin, uint8_t extraBits) {
+	uint16_t counts = readOversampledCounts(pin, extraBits);
+
+	return VOLTAGE_MAX * (float) counts / ((uint32_t) SENSOR_MAX_OUT << extraBits);
+}
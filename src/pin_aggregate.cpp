@@ -0,0 +1,103 @@
+/**
+ * @file pin_aggregate.cpp
+ *
+ * @brief Implementation of the pin voltage summaries defined in pin_aggregate.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "pin_aggregate.h"
+
+#if PIN_AGGREGATE_ENABLED
+
+static const uint8_t aggregatePins[] = {PIN_AGGREGATE_PINS};
+
+#define NUM_AGGREGATE_PINS (sizeof(aggregatePins) / sizeof(aggregatePins[0]))
+
+static_assert(SENSOR_MAX_OUT % PIN_HISTOGRAM_BINS == 0, "histogram bins must split the ADC range evenly");
+
+static pinAggregateStruct aggregates[NUM_AGGREGATE_PINS];
+static unsigned long windowStartMs = 0;
+
+void aggregatePinSample(uint8_t pin, uint16_t counts) {
+	for (uint8_t i = 0; i < NUM_AGGREGATE_PINS; i++) {
+		if (aggregatePins[i] != pin)
+			continue;
+
+		pinAggregateStruct* aggregate = &aggregates[i];
+		// Full, leave the rest of the window out rather than wrap the count
+		if (aggregate->count == 0xFFFF)
+			return;
+
+		if (aggregate->count == 0 || counts < aggregate->min)
+			aggregate->min = counts;
+		if (counts > aggregate->max)
+			aggregate->max = counts;
+		aggregate->sum += counts;
+		aggregate->count++;
+#ifdef PIN_AGGREGATE_HISTOGRAM
+		aggregate->histogram[counts / (SENSOR_MAX_OUT / PIN_HISTOGRAM_BINS)]++;
+#endif
+		return;
+	}
+}
+
+static void sendSummary(const pinAggregateStruct* aggregate, uint8_t pin) {
+	struct dataBlob* dataBlob = newPinSummaryDataBlob();
+
+	dataMarshall_uint8(dataBlob, pin);
+	dataMarshall_uint8(dataBlob, (aggregate->count > 0xFF) ? 0xFF : aggregate->count);
+	if (aggregate->count) {
+		dataMarshall_uint16(dataBlob, aggregate->min);
+		dataMarshall_uint16(dataBlob, aggregate->max);
+		dataMarshall_uint16(dataBlob, aggregate->sum / aggregate->count);
+	} else {
+		// Nothing read this window
+		dataMarshall_uint16(dataBlob, 0);
+		dataMarshall_uint16(dataBlob, 0);
+		dataMarshall_uint16(dataBlob, 0);
+	}
+
+	sendMarshalledData(dataBlob);
+	FREE_DATA_BLOB(dataBlob);
+}
+
+#ifdef PIN_AGGREGATE_HISTOGRAM
+static void sendHistogram(const pinAggregateStruct* aggregate, uint8_t pin) {
+	for (uint8_t first = 0; first < PIN_HISTOGRAM_BINS; first += PIN_HISTOGRAM_FRAME_BINS) {
+		struct dataBlob* dataBlob = newPinHistogramDataBlob();
+
+		dataMarshall_uint8(dataBlob, pin);
+		dataMarshall_uint8(dataBlob, first);
+		for (uint8_t bin = first; bin < first + PIN_HISTOGRAM_FRAME_BINS; bin++) {
+			uint8_t share = 0;
+			if (bin < PIN_HISTOGRAM_BINS && aggregate->histogram[bin])
+				share = ((uint32_t) aggregate->histogram[bin] * 0xFF + aggregate->count - 1) / aggregate->count;
+			dataMarshall_uint8(dataBlob, share);
+		}
+
+		sendMarshalledData(dataBlob);
+		FREE_DATA_BLOB(dataBlob);
+	}
+}
+#endif
+
+void sendPinSummaries() {
+	if (millis() - windowStartMs < PIN_AGGREGATE_WINDOW_MS)
+		return;
+	windowStartMs = millis();
+
+	for (uint8_t i = 0; i < NUM_AGGREGATE_PINS; i++) {
+		sendSummary(&aggregates[i], aggregatePins[i]);
+#ifdef PIN_AGGREGATE_HISTOGRAM
+		sendHistogram(&aggregates[i], aggregatePins[i]);
+#endif
+		memset(&aggregates[i], 0, sizeof(aggregates[i]));
+	}
+}
+
+#endif  // PIN_AGGREGATE_ENABLED
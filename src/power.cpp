@@ -0,0 +1,41 @@
+/**
+ * @file power.cpp
+ *
+ * @brief Implementation of the idle mode defined in power.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "power.h"
+#include "params.h"
+
+#include <avr/power.h>
+#include <avr/sleep.h>
+
+void initPower() {
+	power_twi_disable();
+	power_spi_disable();
+}
+
+void idleUntil(unsigned long wakeMs) {
+	set_sleep_mode(SLEEP_MODE_IDLE);
+
+	// The Timer0 overflow or the bumper can wake it early
+	while (true) {
+		// Interrupts stay off until the instruction after sei(), so one can't slip in
+		// between the check and going to sleep
+		noInterrupts();
+		if ((long) (millis() - wakeMs) >= 0 || bumperLatched()) {
+			interrupts();
+			break;
+		}
+		sleep_enable();
+		interrupts();
+		sleep_cpu();
+		sleep_disable();
+	}
+}
@@ -0,0 +1,348 @@
+"""
+@file profileSymbols.py
+
+@brief Turns the sampling profiler's telemetry frames into a flat profile and folded stacks.
+
+Reads the telemetry stream, from a capture file or straight off the serial port, and picks out
+the profiler frames: header 0xAB, then three program counters (word addresses) and the running
+count of samples the robot dropped, all uint16 little endian. Every other frame is skipped by
+its length. Each PC is looked up in the symbol table of the firmware .elf with nm, and with
+addr2line when it is available, for the source line and any inlined calls.
+
+The flat profile goes to stdout. The folded stacks (`outer;inner count`, one line each) go to
+--folded, ready for flamegraph.pl or speedscope.
+
+--check-isr disassembles the sampling interrupt in the .elf with avr-objdump first, and fails
+unless it reads the PC from just above what its prologue pushed. The interrupt is naked, so
+nothing but that count keeps the Z+16/Z+17 reads pointing at the return address.
+
+Usage:
+    python3 profileSymbols.py capture.bin --elf build/sampling/lightTrackingRobot.ino.elf
+    python3 profileSymbols.py --port /dev/ttyACM1 --seconds 20 --save capture.bin --elf ...
+    python3 profileSymbols.py --check-isr --elf build/sampling/lightTrackingRobot.ino.elf
+
+Part of the lightTrackingRobot project.
+
+@author Wesley Campbell
+@date   2026-10-18
+@version 1.0.0
+"""
+
+import argparse
+import bisect
+import struct
+import subprocess
+import sys
+import time
+
+from collections import Counter
+
+PROFILER_PACKET_HEADER = 0xAB
+PROFILER_FRAME_SAMPLES = 3
+
+# Payload length of every frame the firmware sends, see communicate.h
+HEADERS = {
+        0xAA: 3,
+        0xBB: 3,
+        0xCC: 5,
+        0xDD: 7,
+        0xEE: 7,
+        0xCD: 8,
+        0xCE: 8,
+        0xDA: 7,
+        0xDB: 8,
+        PROFILER_PACKET_HEADER: 8
+        }
+
+TEXT_SYMBOL_TYPES = "tTwW"
+
+# TIMER0_COMPA_vect on the ATmega328P, and the I/O address of SPL
+PROFILER_ISR = "__vector_14"
+SPL_IO_ADDRESS = 0x3d
+
+###################################################################3
+
+#                        CAPTURE
+
+###################################################################3
+
+def read_port(port, seconds, baud):
+    import serial
+
+    data = bytearray()
+    with serial.Serial(port, baud, timeout=0.1) as serialPort:
+        end = time.time() + seconds
+        while time.time() < end:
+            data += serialPort.read(256)
+    return bytes(data)
+
+def parse_frames(data):
+    """
+    @brief Pulls the samples out of a telemetry stream
+
+    @return (list of PCs, samples the robot dropped)
+    """
+    pcs = []
+    dropped = 0
+    i = 0
+
+    while i < len(data):
+        header = data[i]
+        if header not in HEADERS:
+            i += 1
+            continue
+
+        size = HEADERS[header]
+        payload = data[i + 1:i + 1 + size]
+        if len(payload) < size:
+            break
+
+        if header == PROFILER_PACKET_HEADER:
+            values = struct.unpack('<4H', payload)
+            pcs.extend(values[:PROFILER_FRAME_SAMPLES])
+            dropped = values[PROFILER_FRAME_SAMPLES]
+
+        i += 1 + size
+
+    return pcs, dropped
+
+###################################################################3
+
+#                        SYMBOLS
+
+###################################################################3
+
+class SymbolTable:
+    def __init__(self, elf, nm):
+        output = subprocess.run([nm, "-C", "-n", "-S", "--defined-only", elf],
+                                capture_output=True, text=True, check=True).stdout
+
+        self.starts = []
+        self.symbols = []
+        self.base = 0
+
+        for line in output.splitlines():
+            fields = line.split(None, 3)
+            if len(fields) == 4:
+                address, size, kind, name = fields
+                size = int(size, 16)
+            elif len(fields) == 3:
+                address, kind, name = fields
+                size = None
+            else:
+                continue
+
+            if name == "__executable_start":
+                self.base = int(address, 16)
+            if kind not in TEXT_SYMBOL_TYPES:
+                continue
+
+            self.starts.append(int(address, 16))
+            self.symbols.append((name, size))
+
+    def lookup(self, address):
+        index = bisect.bisect_right(self.starts, address) - 1
+        if index < 0:
+            return "??"
+
+        name, size = self.symbols[index]
+        if size is not None and address >= self.starts[index] + size:
+            return "??"
+        return name
+
+def inline_chains(elf, addr2line, addresses):
+    """
+    @brief Asks addr2line for the inlined call chain at each address, outermost first
+
+    @return dict of address to [(function, file:line), ...], empty if addr2line isn't there
+    """
+    if not addr2line or not addresses:
+        return {}
+
+    # A sentinel address after each real one marks where its chain ends
+    query = []
+    for address in addresses:
+        query += [hex(address), "0x0"]
+
+    try:
+        output = subprocess.run([addr2line, "-e", elf, "-f", "-C", "-i"] + query,
+                                capture_output=True, text=True, check=True).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError):
+        return {}
+
+    chains = {}
+    lines = iter(zip(output[0::2], output[1::2]))
+    for address in addresses:
+        chain = []
+        for function, location in lines:
+            chain.append((function, location))
+            # The sentinel resolves to nothing
+            if function == "??" and location.startswith("??"):
+                break
+        else:
+            break
+
+        chain = chain[:-1]
+        chains[address] = [(f, l) for f, l in reversed(chain) if f != "??"]
+
+    return chains
+
+###################################################################3
+
+#                        SAMPLER CHECK
+
+###################################################################3
+
+def disassemble(elf, objdump, function):
+    """
+    @brief Pulls one function's instructions out of the objdump disassembly
+
+    @return list of (mnemonic, operands), empty if the function isn't there
+    """
+    output = subprocess.run([objdump, "-d", elf], capture_output=True, text=True, check=True).stdout
+
+    instructions = []
+    inside = False
+    for line in output.splitlines():
+        if line.endswith(f"<{function}>:"):
+            inside = True
+            continue
+        if not inside:
+            continue
+        # A blank line ends the function
+        if not line.strip():
+            break
+
+        # "  41e:\ted b7       \tin\tr30, 0x3d\t; 61"
+        fields = line.split("\t")
+        if len(fields) < 3:
+            continue
+        operands = fields[3].split(";")[0].strip() if len(fields) > 3 else ""
+        instructions.append((fields[2].strip(), operands))
+
+    return instructions
+
+def check_sampler(elf, objdump):
+    """
+    @brief Checks the sampling interrupt reads the return address from where its pushes left it
+
+    The interrupt pushes the return address, high byte at the lower address, then the prologue
+    pushes its registers. With SP copied to Z, the high byte is at Z + pushes + 1.
+
+    @return a message saying what's wrong, or None if it's right
+    """
+    try:
+        instructions = disassemble(elf, objdump, PROFILER_ISR)
+    except (OSError, subprocess.CalledProcessError) as error:
+        return f"can't disassemble {elf} with {objdump}: {error}"
+    if not instructions:
+        return f"no {PROFILER_ISR} in {elf}"
+
+    pushes = 0
+    for i, (mnemonic, operands) in enumerate(instructions):
+        if mnemonic == "push":
+            pushes += 1
+        elif mnemonic == "in" and operands.replace(" ", "") == f"r30,{SPL_IO_ADDRESS:#x}":
+            break
+    else:
+        return f"{PROFILER_ISR} never copies SP into Z"
+
+    reads = [operands.replace(" ", "") for mnemonic, operands in instructions[i:] if mnemonic == "ldd"][:2]
+    expected = [f"r25,Z+{pushes + 1}", f"r24,Z+{pushes + 2}"]
+    if reads != expected:
+        return f"{PROFILER_ISR} pushes {pushes} bytes, so should read {expected}, but reads {reads}"
+
+    pops = sum(1 for mnemonic, _ in instructions if mnemonic == "pop")
+    if pops != pushes:
+        return f"{PROFILER_ISR} pushes {pushes} bytes but pops {pops}"
+
+    print(f"{PROFILER_ISR}: {pushes} bytes pushed, PC read from Z+{pushes + 1}/Z+{pushes + 2}")
+    return None
+
+###################################################################3
+
+#                        REPORT
+
+###################################################################3
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolizes sampling profiler captures")
+    parser.add_argument("capture", nargs="?", help="raw telemetry capture to read")
+    parser.add_argument("--port", help="read the telemetry off this serial port instead")
+    parser.add_argument("--seconds", type=float, default=20, help="how long to read the port for")
+    parser.add_argument("--baud", type=int, default=9600)
+    parser.add_argument("--save", help="write what was read off the port here")
+    parser.add_argument("--elf", required=True, help="the firmware the capture came from")
+    parser.add_argument("--nm", default="avr-nm")
+    parser.add_argument("--addr2line", default="avr-addr2line", help="empty to skip source lines")
+    parser.add_argument("--folded", help="write folded stacks here")
+    parser.add_argument("--top", type=int, default=20, help="functions to list")
+    parser.add_argument("--check-isr", action="store_true",
+                        help="check the sampling interrupt's PC read in the .elf first")
+    parser.add_argument("--objdump", default="avr-objdump")
+    args = parser.parse_args()
+
+    if args.check_isr:
+        problem = check_sampler(args.elf, args.objdump)
+        if problem:
+            print(f"profileSymbols: {problem}", file=sys.stderr)
+            return 1
+        if not args.port and not args.capture:
+            return 0
+
+    if args.port:
+        data = read_port(args.port, args.seconds, args.baud)
+        if args.save:
+            with open(args.save, "wb") as f:
+                f.write(data)
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        parser.error("give a capture file or --port")
+
+    pcs, dropped = parse_frames(data)
+    if not pcs:
+        print("No profiler samples in the capture", file=sys.stderr)
+        return 1
+
+    symbols = SymbolTable(args.elf, args.nm)
+
+    # Word addresses, and the return address is just past the instruction that was interrupted
+    addresses = Counter(symbols.base + pc * 2 for pc in pcs)
+    chains = inline_chains(args.elf, args.addr2line, sorted(addresses))
+
+    functions = Counter()
+    hottestLine = {}
+    folded = Counter()
+    for address, count in addresses.items():
+        name = symbols.lookup(address)
+        functions[name] += count
+
+        chain = chains.get(address, [])
+        if chain and (name not in hottestLine or count > hottestLine[name][1]):
+            hottestLine[name] = (chain[-1][1], count)
+
+        stack = [function for function, _ in chain] or [name]
+        if stack[0] != name:
+            stack.insert(0, name)
+        folded[";".join(stack)] += count
+
+    total = len(pcs)
+    print(f"{total} samples, {dropped} dropped on the robot, {len(functions)} functions")
+    print(f"{'%':>6} {'samples':>8}  function")
+    for name, count in functions.most_common(args.top):
+        line = hottestLine.get(name, ("", 0))[0]
+        line = f"  ({line})" if line and not line.startswith("??") else ""
+        print(f"{100 * count / total:6.1f} {count:8d}  {name}{line}")
+
+    if args.folded:
+        with open(args.folded, "w") as f:
+            for stack, count in sorted(folded.items()):
+                f.write(f"{stack} {count}\n")
+        print(f"Folded stacks written to {args.folded}")
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,137 @@
+/**
+ * @file profiler.cpp
+ *
+ * @brief Implementation of the sampling profiler defined in profiler.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "profiler.h"
+
+#if FEATURE_PROFILER
+
+#include <avr/interrupt.h>
+
+static_assert(PROFILER_DIVIDER > 0 && PROFILER_DIVIDER <= 255, "the divider is counted in 8 bits");
+static_assert(PROFILER_RING <= 256 && (PROFILER_RING & (PROFILER_RING - 1)) == 0, "ring indexes wrap as 8 bits");
+
+static volatile uint16_t ring[PROFILER_RING];
+static volatile uint8_t ringHead = 0;		// written by the interrupt
+static volatile uint8_t ringTail = 0;		// written by sendProfilerSamples()
+static volatile uint16_t dropped = 0;
+static uint8_t countdown = PROFILER_DIVIDER;
+
+void initProfiler() {
+	noInterrupts();
+	OCR0A = PROFILER_COMPARE;
+	TIFR0 = _BV(OCF0A);
+	TIMSK0 |= _BV(OCIE0A);
+	interrupts();
+}
+
+void profilerRecord(uint16_t pc) {
+	if (--countdown)
+		return;
+	countdown = PROFILER_DIVIDER;
+
+	// Drop the new sample rather than an old one, the count tells the host how many
+	uint8_t next = (ringHead + 1) % PROFILER_RING;
+	if (next == ringTail) {
+		dropped++;
+		return;
+	}
+
+	ring[ringHead] = pc;
+	ringHead = next;
+}
+
+#if defined(__AVR__)
+
+/*
+ * Naked, so the stack layout is known: the return address, the interrupted PC, sits right
+ * above the 15 bytes pushed here, high byte first. Saves everything profilerRecord() may
+ * clobber, as a normal ISR would.
+ */
+ISR(TIMER0_COMPA_vect, ISR_NAKED) {
+	__asm volatile (
+		"    push r0                \n"
+		"    in r0, __SREG__        \n"
+		"    push r0                \n"
+		"    push r1                \n"
+		"    clr r1                 \n"
+		"    push r18               \n"
+		"    push r19               \n"
+		"    push r20               \n"
+		"    push r21               \n"
+		"    push r22               \n"
+		"    push r23               \n"
+		"    push r24               \n"
+		"    push r25               \n"
+		"    push r26               \n"
+		"    push r27               \n"
+		"    push r30               \n"
+		"    push r31               \n"
+		"    in r30, __SP_L__       \n"
+		"    in r31, __SP_H__       \n"
+		"    ldd r25, Z+16          \n"
+		"    ldd r24, Z+17          \n"
+		"    call profilerRecord    \n"
+		"    pop r31                \n"
+		"    pop r30                \n"
+		"    pop r27                \n"
+		"    pop r26                \n"
+		"    pop r25                \n"
+		"    pop r24                \n"
+		"    pop r23                \n"
+		"    pop r22                \n"
+		"    pop r21                \n"
+		"    pop r20                \n"
+		"    pop r19                \n"
+		"    pop r18                \n"
+		"    pop r1                 \n"
+		"    pop r0                 \n"
+		"    out __SREG__, r0       \n"
+		"    pop r0                 \n"
+		"    reti                   \n"
+	);
+}
+
+#else
+
+#include "sim_hardware.h"
+
+// No AVR stack to dig the PC out of, the virtual hardware says where the clock was spent
+ISR(TIMER0_COMPA_vect) {
+	profilerRecord(sim.interruptedPc);
+}
+
+#endif
+
+void sendProfilerSamples() {
+	// Header and payload
+	const int frameBytes = 1 + DATA_BLOB_DATA_SIZE;
+
+	while ((uint8_t) (ringHead - ringTail) % PROFILER_RING >= PROFILER_FRAME_SAMPLES
+			&& Serial.availableForWrite() >= frameBytes) {
+		struct dataBlob* dataBlob = newProfilerDataBlob();
+
+		for (int i = 0; i < PROFILER_FRAME_SAMPLES; i++) {
+			dataMarshall_uint16(dataBlob, ring[ringTail]);
+			ringTail = (ringTail + 1) % PROFILER_RING;
+		}
+
+		noInterrupts();
+		uint16_t droppedNow = dropped;
+		interrupts();
+		dataMarshall_uint16(dataBlob, droppedNow);
+
+		sendMarshalledData(dataBlob);
+		FREE_DATA_BLOB(dataBlob);
+	}
+}
+
+#endif  // FEATURE_PROFILER
@@ -16,50 +16,103 @@
 #include "capacitive_touch.h"
 #include "includes.h"
 #include "lightDirection.h"
+#include "memory_monitor.h"
 #include "params.h"
 #include "robot_states.h"
 
-detectionDataStruct detectedData;
+detectionDataStruct detectedData = NEW_DETECTION_DATA_STRUCT;
 
-actionStateStruct actionStates;
+actionStateStruct actionStates = NEW_ACTION_STATE_STRUCT;
 
 float batteryVoltage = 0;
 BATTERY_LEVEL batteryVoltageLevel;
 
 int capacitiveTouchDetected = DETECTION_FALSE;
 CAP_STATE capState = CAP_WAITING;
-ROBOT_SPEED robotSpeed = SLOW;
+ROBOT_SPEED robotSpeed = ROBOT_START_SPEED;
 
+#if FEATURE_SERVO
 extern Servo servo;
 extern int servoAngle;
+#endif
 extern NewPing sonarSensor;
 
 // ========================== DETECTION STATE FUNCTIONS =============================
 
 float readPinVoltage(uint8_t pin) {
+	uint16_t counts = analogRead(pin);
+	aggregatePinSample(pin, counts);
+
 	// Maps the reading of the analog pin to the voltage scale
-	return VOLTAGE_MAX * (float) analogRead(pin) / SENSOR_MAX_OUT;
+	return VOLTAGE_MAX * (float) counts / SENSOR_MAX_OUT;
 }
 
 bool buttonPushed(uint8_t button_pin) {
-	if (analogRead(button_pin) >= BUTTON_VTHRESHOLD)
+	if (readPinVoltage(button_pin) >= BUTTON_VTHRESHOLD)
 		return true;
 	else
 		return false;
 }
 
+float closingSpeed = 0;
+
+void updateClosingSpeed(int previousCm, int currentCm, unsigned long dtMs) {
+	// Need two ranges in a row to say anything about speed
+	if (previousCm == 0 || currentCm == 0 || dtMs == 0) {
+		closingSpeed = 0;
+		return;
+	}
+
+	float measured = (previousCm - currentCm) * 1000.0 / dtMs;
+	closingSpeed += CLOSING_SPEED_FILTER * (measured - closingSpeed);
+}
+
+uint8_t computeBrakeScale(int distanceCm) {
+#ifdef COLLISION_FIXED_STOP
+	(void) distanceCm;
+	return BRAKE_NONE;
+#else
+	if (distanceCm == 0 || closingSpeed <= 0)
+		return BRAKE_NONE;
+
+	// Time until we reach the stopping distance at the current closing speed
+	float ttcMs = 1000.0 * (distanceCm - COLLISION_DISTANCE) / closingSpeed;
+
+	if (ttcMs <= TTC_STOP_MS)
+		return 0;
+	if (ttcMs >= TTC_SLOW_MS)
+		return BRAKE_NONE;
+
+	// Ease off linearly from full speed down to BRAKE_MIN_SCALE
+	return BRAKE_MIN_SCALE + (BRAKE_NONE - BRAKE_MIN_SCALE) * (ttcMs - TTC_STOP_MS) / (TTC_SLOW_MS - TTC_STOP_MS);
+#endif
+}
+
 bool collisionDetected() {	
 	static unsigned long lastPing = 0;
 	static int sonarDistance = 0;
 
-	if (millis() - lastPing > 40) {
-		lastPing = millis();
+	if (millis() - lastPing > ULTRASONIC_PING_INTERVAL) {
+		unsigned long now = millis();
+		int previousDistance = sonarDistance;
+
 		sonarDistance = sonarSensor.ping_cm();  // returns 0 when distance too far
+		if (sonarDistance != 0) {
+			sonarDistance += calibration.sonarOffsetCm;
+			if (sonarDistance < 1)
+				sonarDistance = 1;
+		}
+		updateClosingSpeed(previousDistance, sonarDistance, now - lastPing);
+		detectedData.brakeScale = computeBrakeScale(sonarDistance);
+
+		lastPing = now;
+#if FEATURE_DEBUG
 		Serial.println(sonarDistance);
+#endif
 	}
 
 	if (sonarDistance != 0) {
-		return sonarDistance <= COLLISION_DISTANCE;	
+		return sonarDistance <= COLLISION_DISTANCE || detectedData.brakeScale == 0;	
 	}
 
 	return false;
@@ -68,42 +121,47 @@ bool collisionDetected() {
 void checkLight() {
 	LIGHT_DIR lightDir = detectLightDirection();
 
-	if (lightDir & LIGHT_DOWN)
-		detectedData.lightDetected.down = DETECTION_TRUE;
-	else
-		detectedData.lightDetected.down = DETECTION_FALSE;
-
-	if (lightDir & LIGHT_UP)
-		detectedData.lightDetected.up = DETECTION_TRUE;
-	else
-		detectedData.lightDetected.up = DETECTION_FALSE;
-
-	if (lightDir & LIGHT_LEFT)
-		detectedData.lightDetected.left = DETECTION_TRUE;
-	else
-		detectedData.lightDetected.left = DETECTION_FALSE;
-
-	if (lightDir & LIGHT_RIGHT)
-		detectedData.lightDetected.right = DETECTION_TRUE;
-	else
-		detectedData.lightDetected.right = DETECTION_FALSE;
-
+	detectedData.lightDetected.down = (lightDir & LIGHT_DOWN) ? DETECTION_TRUE : DETECTION_FALSE;
+	detectedData.lightDetected.up = (lightDir & LIGHT_UP) ? DETECTION_TRUE : DETECTION_FALSE;
+	detectedData.lightDetected.left = (lightDir & LIGHT_LEFT) ? DETECTION_TRUE : DETECTION_FALSE;
+	detectedData.lightDetected.right = (lightDir & LIGHT_RIGHT) ? DETECTION_TRUE : DETECTION_FALSE;
 }
 
 void RobotDetection() {
-	// Check for an immemant collision
-	if (collisionDetected()) {
+	bool idle = actionStates.Idle == IDLE_ACTIVE;
+
+	// Check for an immemant collision, or one the bumper already caught.
+	// The motors are off while idle, so there is no need to ping.
+	if (bumperLatched() || (!idle && collisionDetected())) {
 		detectedData.collisionDetected = DETECTION_TRUE;
 	} else {
 		detectedData.collisionDetected = DETECTION_FALSE;
 	}
+	updateBumperLatch();
 
 	checkLight();
 
-	if (detectCapTouch()) {
-		capacitiveTouchDetected = DETECTION_TRUE;
+#if FEATURE_CAP_TOUCH
+	static unsigned long lastCapCheck = 0;
+	if (!idle || millis() - lastCapCheck >= IDLE_CAP_INTERVAL) {
+		lastCapCheck = millis();
+
+		if (detectCapTouch()) {
+			capacitiveTouchDetected = DETECTION_TRUE;
+		} else {
+			capacitiveTouchDetected = DETECTION_FALSE;
+		}
+	}
+#endif
+
+#if FEATURE_BATTERY
+	readBatteryVoltage();
+#endif
+
+	if (updateMemoryMonitor() == MEMORY_LOW) {
+		detectedData.memoryLow = DETECTION_TRUE;
 	} else {
-		capacitiveTouchDetected = DETECTION_FALSE;
+		detectedData.memoryLow = DETECTION_FALSE;
 	}
 }
 
@@ -114,9 +172,11 @@ void fsmCollisionDetection() {
 		// No collision detected
 		case DETECTION_FALSE:
 			actionStates.Collision = COLLISION_INACTIVE; // set all clear flag
+			actionStates.Brake = detectedData.brakeScale;
 			break;
 		case DETECTION_TRUE:
 			actionStates.Collision = COLLISION_ACTIVE; // set collision flag
+			actionStates.Brake = 0;
 			break;
 	}
 
@@ -170,17 +230,34 @@ void fsmServoMovement() {
 }
 
 void fsmBatteryVoltage() {
-	if (batteryVoltage >= 8.1) {
+	if (batteryVoltage >= BATTERY_HIGH_VOLTS) {
 		batteryVoltageLevel = BATTERY_HIGH;
 	} 
-	else if (batteryVoltage >= 7.2) {
+	else if (batteryVoltage >= BATTERY_MED_VOLTS) {
 		batteryVoltageLevel = BATTERY_MED;
 	}
-	else if (batteryVoltage >= 6.3) {
+	else if (batteryVoltage >= BATTERY_DEAD_VOLTS) {
 		batteryVoltageLevel = BATTERY_LOW;
 	} else {
 		batteryVoltageLevel = BATTERY_DEAD; 
 	}
+
+	// Nothing to go on when the divider isn't connected
+	if (batteryVoltage < BATTERY_MIN_VOLTS) {
+		actionStates.Power = POWER_NORMAL;
+		return;
+	}
+
+	switch (actionStates.Power) {
+		case POWER_NORMAL:
+			if (batteryVoltage < BATTERY_REDUCED_VOLTS)
+				actionStates.Power = POWER_REDUCED;
+			break;
+		case POWER_REDUCED:
+			if (batteryVoltage >= BATTERY_REDUCED_VOLTS + BATTERY_REDUCED_HYSTERESIS)
+				actionStates.Power = POWER_NORMAL;
+			break;
+	}
 }
 
 void fsmCapacitiveTouch() {
@@ -199,50 +276,220 @@ void fsmCapacitiveTouch() {
 	}
 }
 
+void fsmMemoryMonitor() {
+	switch (detectedData.memoryLow) {
+		case DETECTION_FALSE:
+			actionStates.Memory = MEMORY_STOP_INACTIVE;
+			break;
+		case DETECTION_TRUE:
+			actionStates.Memory = MEMORY_STOP_ACTIVE;
+			break;
+	}
+}
+
+static bool lightSeen() {
+	return detectedData.lightDetected.left || detectedData.lightDetected.right
+			|| detectedData.lightDetected.up || detectedData.lightDetected.down;
+}
+
+void fsmLightTracker() {
+#ifdef LIGHT_NO_TRACKER
+	actionStates.Track = TRACK_NONE;
+#else
+	actionStates.Track = updateLightTracker(actionStates.Track);
+	if (actionStates.Track == TRACK_NONE)
+		return;
+
+	// Steer for where the light will be by the time the motors respond
+	float bearing = predictedBearing();
+	if (bearing > TRACKER_STEER_DEG)
+		actionStates.Drive = DRIVE_LEFT;
+	else if (bearing < -TRACKER_STEER_DEG)
+		actionStates.Drive = DRIVE_RIGHT;
+	else
+		actionStates.Drive = DRIVE_STRAIGHT;
+#endif
+}
+
+static bool tracking() {
+	return actionStates.Track != TRACK_NONE;
+}
+
+static bool searching() {
+	return actionStates.Search == SEARCH_SCAN || actionStates.Search == SEARCH_TURN
+			|| actionStates.Search == SEARCH_APPROACH;
+}
+
+void fsmLightSearch() {
+#ifdef LIGHT_NO_SEARCH
+	actionStates.Search = SEARCH_INACTIVE;
+#else
+	// Nothing to look for, or no way of getting there
+	if (lightSeen() || tracking() || robotSpeed == STOPPED) {
+		actionStates.Search = SEARCH_INACTIVE;
+		return;
+	}
+
+	// Stays given up until the light turns up or the robot is stopped and started again
+	if (actionStates.Search != SEARCH_GAVE_UP)
+		actionStates.Search = updateLightSearch(actionStates.Search, actionStates.Collision == COLLISION_ACTIVE);
+#endif
+}
+
+void fsmIdle() {
+#ifdef POWER_NO_IDLE
+	actionStates.Idle = IDLE_INACTIVE;
+#else
+
+	// Stay awake through a touch, so the release isn't missed, and while the servo tracks
+#if FEATURE_SERVO
+	bool servoResting = actionStates.Servo == SERVO_MOVE_STOP && servoPlan.velocity == 0;
+#else
+	bool servoResting = true;
+#endif
+
+	if ((robotSpeed == STOPPED || !(lightSeen() || tracking())) && servoResting && capState == CAP_WAITING && !searching()) {
+		actionStates.Idle = IDLE_ACTIVE;
+	} else {
+		actionStates.Idle = IDLE_INACTIVE;
+	}
+#endif
+}
+
 void RobotPlanning() {
 	fsmCollisionDetection();
 	fsmTempLightDetection();
+#if FEATURE_SERVO
 	fsmServoMovement();
+#endif
+	fsmLightTracker();
+#if FEATURE_CAP_TOUCH
 	fsmCapacitiveTouch();
+#endif
+	fsmMemoryMonitor();
+#if FEATURE_BATTERY
+	fsmBatteryVoltage();
+#endif
+	fsmLightSearch();
+	fsmIdle();
 }
 
 // ================================ ACTION STATE FUNCTIONS ======================================
 
 void RobotAction() {
-	uint8_t status;
     handleCollisionAction();
 
+#if FEATURE_CAP_TOUCH
+	handleCapacitiveTouchAction();
+#endif
+
+	handleMemoryAction();
+
+#if FEATURE_BATTERY
+	handleBatteryAction();
+#endif
+
 	handleDriveAction();
 
+#if FEATURE_SERVO
 	handleServoAction();
+#endif
 
-	handleCapacitiveTouchAction();
+#if FEATURE_TELEMETRY
+	debugRobotState();
+#endif
+
+	handleIdleAction();
 }	
 
+#if FEATURE_TELEMETRY && FEATURE_PROFILER
+void debugRobotState() {
+	// The samples get the link to themselves
+	sendProfilerSamples();
+}
+#elif FEATURE_TELEMETRY
+void debugRobotState() {
+	static unsigned long lastMemoryReport = 0;
+	static unsigned long lastBatteryReport = 0;
+	static unsigned long lastDeadlineReport = 0;
+	deadlineRecordStruct resetRecord;
+
+	// The watchdog reset this boot came out of, if it did
+	if (takeDeadlineReset(&resetRecord))
+		printDeadlineReset(&resetRecord);
+
+	printRobotState(&detectedData, &actionStates);
+
+	sendPinSummaries();
+
+	if (millis() - lastMemoryReport >= MEMORY_REPORT_INTERVAL) {
+		lastMemoryReport = millis();
+		printMemoryState(&memoryStats);
+	}
+
+#if FEATURE_BATTERY
+	if (millis() - lastBatteryReport >= BATTERY_REPORT_INTERVAL) {
+		lastBatteryReport = millis();
+		printBatteryState(actionStates.Power);
+	}
+#endif
+
+	if (millis() - lastDeadlineReport >= DEADLINE_REPORT_INTERVAL) {
+		lastDeadlineReport = millis();
+		printDeadlineState();
+	}
+}
+#endif  // FEATURE_TELEMETRY
+
+uint8_t driveSpeed() {
+	uint8_t speed = robotSpeed;
+
+	// Save what's left of the battery
+	if (actionStates.Power == POWER_REDUCED && speed > BATTERY_REDUCED_SPEED)
+		speed = BATTERY_REDUCED_SPEED;
+
+	// Slow down for whatever the sonar says we're closing in on
+	return (uint16_t) speed * actionStates.Brake / BRAKE_NONE;
+}
+
 void enableMotors() {
-	analogWrite(MOTOR_LEFT, robotSpeed);
-	analogWrite(MOTOR_RIGHT, robotSpeed);
+	setMotorSpeed(MOTOR_ID_LEFT, driveSpeed());
+	setMotorSpeed(MOTOR_ID_RIGHT, driveSpeed());
 }
 
 void disableMotors() {
-	analogWrite(MOTOR_LEFT, LOW);
-	analogWrite(MOTOR_RIGHT, LOW);
+	setMotorSpeed(MOTOR_ID_LEFT, LOW);
+	setMotorSpeed(MOTOR_ID_RIGHT, LOW);
 }
 
 void turnLeft() {
-	analogWrite(MOTOR_RIGHT, robotSpeed);
+	setMotorSpeed(MOTOR_ID_LEFT, LOW);
+	setMotorSpeed(MOTOR_ID_RIGHT, driveSpeed());
 }
 
 void turnRight() {
-	analogWrite(MOTOR_LEFT, robotSpeed);
+	setMotorSpeed(MOTOR_ID_LEFT, driveSpeed());
+	setMotorSpeed(MOTOR_ID_RIGHT, LOW);
 }
 
 void driveStraight() {
 	enableMotors();
 }
 
+void searchDrive() {
+	uint8_t speed = driveSpeed();
+	if (speed > SEARCH_SPEED)
+		speed = SEARCH_SPEED;
+
+	// The wheels only go forwards, so pivot on the right wheel to look around
+	setMotorSpeed(MOTOR_ID_LEFT, speed);
+	setMotorSpeed(MOTOR_ID_RIGHT, (actionStates.Search == SEARCH_APPROACH) ? speed : LOW);
+}
+
 void handleDriveAction() {
-	if ((actionStates.Drive & (DRIVE_LEFT | DRIVE_RIGHT)) == (DRIVE_LEFT | DRIVE_RIGHT)) {
+	if (searching()) {
+		searchDrive();
+	} else if ((actionStates.Drive & (DRIVE_LEFT | DRIVE_RIGHT)) == (DRIVE_LEFT | DRIVE_RIGHT)) {
 		driveStraight();
 	} else if (actionStates.Drive & DRIVE_LEFT) {
 		turnLeft();
@@ -251,45 +498,88 @@ void handleDriveAction() {
 	} else {
 		disableMotors();
 	}
+
+	// Ramp towards whatever was just asked for
+	updateMotors();
 }
 
 void handleCollisionAction() {
 	switch(actionStates.Collision) {
 		// If there is no collition, do nothing
 		case COLLISION_INACTIVE:
-			disableLED(LED_COLLISION);
+			disableLED<LED_COLLISION>();
 			break;
 		case COLLISION_ACTIVE:
-			activateLED(LED_COLLISION);
+			activateLED<LED_COLLISION>();
 			// stop the robot
 			actionStates.Drive = DRIVE_STOP;
 			break;
 	}
 }
 
+#if FEATURE_SERVO
 void handleServoAction() {
-	// If SERVO_MOVE_DOWN flag set, move servo down
-	if (actionStates.Servo & SERVO_MOVE_DOWN) {
-		servoAngle -= SERVO_ANGLE_DELTA;
-		if (servoAngle < SERVO_ANGLE_MIN) {
-			servoAngle = SERVO_ANGLE_MIN;
-		}
-		servo.write(servoAngle);
-	}
-	// If SERVO_MOVE_UP flag set, move servo up
-	if (actionStates.Servo & SERVO_MOVE_UP) {
-		servoAngle += SERVO_ANGLE_DELTA;
-		
-		if (servoAngle > SERVO_ANGLE_MAX) {
-			servoAngle = SERVO_ANGLE_MAX;
-		}
+	static uint16_t lastPulse = 0;
+	float targetVelocity = 0;
+
+	// Flags pick the direction, the photodiode imbalance picks how fast
+	if (searching()) {
+		targetVelocity = searchServoVelocity(actionStates.Search);
+	} else if (tracking() && trackerLeadsServo()) {
+		targetVelocity = trackerServoVelocity(servoPlan.position);
+	} else if (actionStates.Servo & SERVO_MOVE_UP) {
+		targetVelocity = servoTrackingSpeed(lightVerticalBalance());
+	} else if (actionStates.Servo & SERVO_MOVE_DOWN) {
+		targetVelocity = -servoTrackingSpeed(lightVerticalBalance());
+	}
+
+	float angle = updateServoPlanner(targetVelocity);
+	servoAngle = (int) (angle + 0.5);
 
-		servo.write(servoAngle);
+	// Only bother the servo when the pulse actually changes
+	uint16_t pulse = servoAngleToPulse(angle);
+	if (pulse != lastPulse) {
+		servo.writeMicroseconds(pulse);
+		lastPulse = pulse;
 	}
 }
+#endif  // FEATURE_SERVO
+
+void handleIdleAction() {
+	static unsigned long lastPass = 0;
+
+	if (actionStates.Idle == IDLE_ACTIVE) {
+#if FEATURE_SERVO
+		// The servo is resting, boot pointing wherever it is now
+		saveServoRest(servoAngle);
+#endif
+		if (millis() - lastPass < IDLE_LIGHT_INTERVAL)
+			idleUntil(lastPass + IDLE_LIGHT_INTERVAL);
+	}
+	lastPass = millis();
+}
+
+void handleBatteryAction() {
+	// Nothing to go on when the divider isn't connected
+	if (batteryVoltage < BATTERY_MIN_VOLTS) {
+		setMotorSupplyScale(256);
+		return;
+	}
 
-void activateLED(uint8_t ledPin) {
-	digitalWrite(ledPin, HIGH);
+	setMotorSupplyScale(batteryCompensation());
+}
+
+void handleMemoryAction() {
+	switch (actionStates.Memory) {
+		case MEMORY_STOP_INACTIVE:
+			break;
+		case MEMORY_STOP_ACTIVE:
+			// Stack and heap are about to collide, park the robot and flag the error
+			robotSpeed = STOPPED;
+			actionStates.Drive = DRIVE_STOP;
+			activateLED<LED_BUILTIN>();
+			break;
+	}
 }
 
 void handleCapacitiveTouchAction() {
@@ -315,7 +605,3 @@ void toggleRobotSpeed() {
 			break;
 	}
 }
-
-void disableLED(uint8_t ledPin) {
-	digitalWrite(ledPin, LOW);
-}
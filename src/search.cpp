@@ -0,0 +1,114 @@
+/**
+ * @file search.cpp
+ *
+ * @brief Implementation of the light search defined in search.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "search.h"
+#include "params.h"
+
+lightSearchStruct lightSearch;
+
+static void startScan(unsigned long now) {
+	lightSearch.phaseMs = now;
+	lightSearch.bestIntensity = 0;
+	lightSearch.dimmestIntensity = VOLTAGE_MAX * NUM_PHOTODIODES;
+}
+
+void startLightSearch() {
+	lightSearch.startMs = millis();
+	lightSearch.bestTilt = servoPlan.position;
+	lightSearch.tiltDirection = 1;
+	startScan(lightSearch.startMs);
+}
+
+float lightIntensity() {
+	float total = 0;
+
+	for (int i = 0; i < NUM_PHOTODIODES; i++)
+		total += photodiodeVoltages[i];
+	return total;
+}
+
+uint8_t updateLightSearch(uint8_t phase, bool blocked) {
+	unsigned long now = millis();
+	float intensity = lightIntensity();
+
+	if (phase != SEARCH_INACTIVE && phase != SEARCH_WAITING && now - lightSearch.startMs >= SEARCH_TIMEOUT_MS)
+		return SEARCH_GAVE_UP;
+
+	switch (phase) {
+		case SEARCH_INACTIVE:
+			lightSearch.phaseMs = now;
+			return SEARCH_WAITING;
+
+		case SEARCH_WAITING:
+			// Don't go looking every time the light flickers
+			if (now - lightSearch.phaseMs < SEARCH_DELAY_MS)
+				return SEARCH_WAITING;
+			startLightSearch();
+			return SEARCH_SCAN;
+
+		case SEARCH_SCAN:
+			if (intensity > lightSearch.bestIntensity) {
+				lightSearch.bestIntensity = intensity;
+				lightSearch.bestTilt = servoPlan.position;
+			}
+			if (intensity < lightSearch.dimmestIntensity)
+				lightSearch.dimmestIntensity = intensity;
+
+			if (now - lightSearch.phaseMs < SEARCH_SCAN_MS)
+				return SEARCH_SCAN;
+
+			lightSearch.phaseMs = now;
+			// Nothing brighter than the room, strike out and look again somewhere else
+			if (lightSearch.bestIntensity - lightSearch.dimmestIntensity < SEARCH_MIN_CONTRAST)
+				return SEARCH_APPROACH;
+			return SEARCH_TURN;
+
+		case SEARCH_TURN:
+			// Measured above the room, so a faint light still has to be faced properly
+			if (intensity - lightSearch.dimmestIntensity
+					>= SEARCH_RETURN_FRACTION * (lightSearch.bestIntensity - lightSearch.dimmestIntensity)) {
+				lightSearch.phaseMs = now;
+				return SEARCH_APPROACH;
+			}
+			// Went all the way round without finding it again
+			if (now - lightSearch.phaseMs >= SEARCH_SCAN_MS) {
+				startScan(now);
+				return SEARCH_SCAN;
+			}
+			return SEARCH_TURN;
+
+		case SEARCH_APPROACH:
+			if (blocked || now - lightSearch.phaseMs >= SEARCH_APPROACH_MS) {
+				startScan(now);
+				return SEARCH_SCAN;
+			}
+			return SEARCH_APPROACH;
+
+		default:
+			return phase;
+	}
+}
+
+float searchServoVelocity(uint8_t phase) {
+	float position = servoPlan.position;
+
+	if (phase == SEARCH_SCAN) {
+		// The planner stops dead at the limits, turn round just before them
+		if (position >= calibration.servoMax - SEARCH_TILT_MARGIN)
+			lightSearch.tiltDirection = -1;
+		else if (position <= calibration.servoMin + SEARCH_TILT_MARGIN)
+			lightSearch.tiltDirection = 1;
+		return lightSearch.tiltDirection * SEARCH_TILT_VELOCITY;
+	}
+
+	return SEARCH_TILT_GAIN * (lightSearch.bestTilt - position);
+}
@@ -58,19 +58,40 @@ ACTIONS_LEN = len(ACTIONS)
 
 PIN_VOLTAGE_MAX = 5
 
+# Pin summaries come in raw ADC counts, see pin_aggregate.h
+VOLTS_PER_COUNT = 5.10 / 1024
+HISTOGRAM_BINS = 16
+
 GRAPH_WINDOW = 200
 X_AXIS = list(range(GRAPH_WINDOW))
 
 DATA_PACKET_HEADER = 0xAA
 ACTION_PACKET_HEADER = 0xBB
 PIN_DATA_PACKET_HEADER = 0xCC
+MEMORY_PACKET_HEADER = 0xDD
+BATTERY_PACKET_HEADER = 0xEE
+PROFILER_PACKET_HEADER = 0xAB
+PIN_SUMMARY_PACKET_HEADER = 0xCD
+PIN_HISTOGRAM_PACKET_HEADER = 0xCE
+DEADLINE_PACKET_HEADER = 0xDA
+DEADLINE_RESET_PACKET_HEADER = 0xDB
 
 HEADERS = {
         DATA_PACKET_HEADER: 3,
         ACTION_PACKET_HEADER: 3,
-        PIN_DATA_PACKET_HEADER: 5
+        PIN_DATA_PACKET_HEADER: 5,
+        MEMORY_PACKET_HEADER: 7,
+        BATTERY_PACKET_HEADER: 7,
+        PROFILER_PACKET_HEADER: 8,
+        PIN_SUMMARY_PACKET_HEADER: 8,
+        PIN_HISTOGRAM_PACKET_HEADER: 8,
+        DEADLINE_PACKET_HEADER: 7,
+        DEADLINE_RESET_PACKET_HEADER: 8
         }
 
+# Phases of loop() the deadline monitor times, see deadline_monitor.h
+DEADLINE_PHASES = ("detection", "planning", "action", "outside loop()")
+
 PLOT_INTERVAL = 0.09
 
 GRAPH_AMPLITUDE = 0.4
@@ -90,6 +111,13 @@ buffers_actions = [deque(maxlen=GRAPH_WINDOW) for _ in range(ACTIONS_LEN)]
 lines_pins = {}
 buffers_pin_data = {}
 
+# Min and max of each summarised pin, drawn as a band round its mean
+buffers_pin_min = {}
+buffers_pin_max = {}
+envelopes_pins = {}
+histograms_pins = {}
+ax_pins = None
+
 ###################################################################3
 
 #                        DATA READ METHODS
@@ -119,6 +147,72 @@ def read_packet(serialPort):
 
     return (header, payload)
 
+def decode_frames_python(data, offset=0):
+    """
+    @brief Decodes a whole capture one byte at a time, resynchronising like read_packet()
+
+    @return The same columns as framedecoder.decode(), as lists
+    """
+    columns = {
+            "sensor": {"offset": [], "light": [], "collision": [], "capacitive": []},
+            "action": {"offset": [], "collision": [], "drive": [], "servo": []},
+            "pin": {"offset": [], "pin": [], "voltage": []},
+            "consumed": 0,
+            "other_frames": 0,
+            "skipped_bytes": 0
+            }
+
+    i = 0
+    while i < len(data):
+        header = data[i]
+        if header not in HEADERS.keys():
+            columns["skipped_bytes"] += 1
+            i += 1
+            continue
+
+        packet_size = HEADERS[header]
+        payload = data[i + 1:i + 1 + packet_size]
+        if len(payload) != packet_size:
+            break
+
+        if header == DATA_PACKET_HEADER:
+            light = unpack_light_data(payload[0])
+            table = columns["sensor"]
+            table["light"].append(sum(bit << n for n, bit in enumerate(light)))
+            table["collision"].append(payload[1])
+            table["capacitive"].append(payload[2])
+        elif header == ACTION_PACKET_HEADER:
+            table = columns["action"]
+            table["collision"].append(payload[0])
+            table["drive"].append(payload[1])
+            table["servo"].append(payload[2])
+        elif header == PIN_DATA_PACKET_HEADER:
+            table = columns["pin"]
+            table["pin"].append(payload[0])
+            table["voltage"].append(parsePinVoltageData(payload[1:5])[0])
+        else:
+            table = None
+            columns["other_frames"] += 1
+
+        if table is not None:
+            table["offset"].append(offset + i)
+        i += 1 + packet_size
+
+    columns["consumed"] = i
+    return columns
+
+def decode_frames(data, offset=0):
+    """
+    @brief Decodes a whole capture into columns, natively when framedecoder is built
+
+    `make frame-decoder` builds it into build/host, put that on PYTHONPATH
+    """
+    try:
+        import framedecoder
+    except ImportError:
+        return decode_frames_python(data, offset)
+    return framedecoder.decode(data, offset)
+
 def unpack_light_data(byte):
     return [(byte >> i) & 1 for i in range(4)]
 
@@ -169,6 +263,63 @@ def readPayload(serialPort, ax):
         update_pin_data(pinNumber, voltage)
         ax[2].legend()
 
+    def handlePinSummaryPacket(payload):
+        pinNumber, count, low, high, mean = struct.unpack('<BBHHH', payload)
+
+        if pinNumber not in buffers_pin_data.keys():
+            buffers_pin_data[pinNumber] = deque(maxlen=GRAPH_WINDOW)
+
+            line, = ax[2].plot([], [], label=f"Pin {pinNumber}")
+            lines_pins[pinNumber] = line
+            ax[2].legend()
+
+        if pinNumber not in buffers_pin_min.keys():
+            buffers_pin_min[pinNumber] = deque(maxlen=GRAPH_WINDOW)
+            buffers_pin_max[pinNumber] = deque(maxlen=GRAPH_WINDOW)
+
+        # Nothing read that window
+        if count == 0:
+            return
+
+        update_pin_data(pinNumber, mean * VOLTS_PER_COUNT)
+        buffers_pin_min[pinNumber].append(low * VOLTS_PER_COUNT)
+        buffers_pin_max[pinNumber].append(high * VOLTS_PER_COUNT)
+
+    def handlePinHistogramPacket(payload):
+        pinNumber, first = payload[0], payload[1]
+        histogram = histograms_pins.setdefault(pinNumber, [0] * HISTOGRAM_BINS)
+
+        for i, share in enumerate(payload[2:]):
+            if first + i < HISTOGRAM_BINS:
+                histogram[first + i] = share
+
+        if first + len(payload) - 2 >= HISTOGRAM_BINS:
+            bars = "".join(" .:-=+*#%@"[min(9, (share * 10) // 256)] for share in histogram)
+            print(f"Pin {pinNumber} histogram 0-{PIN_VOLTAGE_MAX} V: |{bars}|")
+
+    def handleMemoryPacket(payload):
+        freeNow, minMargin, heapTop, status = struct.unpack('<HHHB', payload)
+
+        print(f"Memory: free {freeNow} B, min margin {minMargin} B, heap top 0x{heapTop:04x}"
+              + (" -- LOW MEMORY STOP" if status else ""))
+
+    def handleBatteryPacket(payload):
+        millivolts, runtime, compensation, power = struct.unpack('<HHHB', payload)
+
+        print(f"Battery: {millivolts / 1000:.2f} V, ~{runtime} min left, PWM x{compensation / 256:.2f}"
+              + (" -- REDUCED POWER" if power else ""))
+
+    def handleDeadlinePacket(payload):
+        phase, overruns, maxUs = struct.unpack('<BHI', payload)
+
+        print(f"Deadline: {DEADLINE_PHASES[phase]} longest {maxUs / 1000:.1f} ms, {overruns} overruns")
+
+    def handleDeadlineResetPacket(payload):
+        phase, atMs, phaseMs, resets = struct.unpack('<BIHB', payload)
+
+        print(f"WATCHDOG RESET: {DEADLINE_PHASES[phase]} overran, {phaseMs} ms in, "
+              f"{atMs / 1000:.1f} s after boot ({resets} since power on)")
+
     ### Read the packet
 
     reading = read_packet(serialPort)
@@ -184,6 +335,18 @@ def readPayload(serialPort, ax):
         handleActionPacket(payload)
     elif (header == PIN_DATA_PACKET_HEADER):
         handlePinPacket(payload)
+    elif (header == PIN_SUMMARY_PACKET_HEADER):
+        handlePinSummaryPacket(payload)
+    elif (header == PIN_HISTOGRAM_PACKET_HEADER):
+        handlePinHistogramPacket(payload)
+    elif (header == MEMORY_PACKET_HEADER):
+        handleMemoryPacket(payload)
+    elif (header == BATTERY_PACKET_HEADER):
+        handleBatteryPacket(payload)
+    elif (header == DEADLINE_PACKET_HEADER):
+        handleDeadlinePacket(payload)
+    elif (header == DEADLINE_RESET_PACKET_HEADER):
+        handleDeadlineResetPacket(payload)
 
 ###################################################################3
 
@@ -218,7 +381,8 @@ def _init_action_plot(fig, ax):
     ax.set_xlabel("Time")
 
 def _init_pin_plot(fig, ax):
-    # lines_pins.append(ax.plot([], []))
+    global ax_pins
+    ax_pins = ax
 
     ax.set_ylim(-0.125, PIN_VOLTAGE_MAX + 1)
     ax.set_xlim(0, GRAPH_WINDOW)
@@ -270,6 +434,17 @@ def _update_pin_data_plot():
         lines_pins[pin].set_ydata(buf)
         lines_pins[pin].set_xdata(X_AXIS[:len(buf)])
 
+    # Summarised pins: the band from each window's min to its max, so spikes still show
+    for pin in buffers_pin_min.keys():
+        if pin in envelopes_pins:
+            envelopes_pins[pin].remove()
+
+        low = buffers_pin_min[pin]
+        high = buffers_pin_max[pin]
+        envelopes_pins[pin] = ax_pins.fill_between(X_AXIS[:len(low)], low, high,
+                                                   color=lines_pins[pin].get_color(),
+                                                   alpha=0.25, linewidth=0)
+
 def update_plot():
     # for i, buf in enumerate(buffers):
     #     y = [v + i for v in buf]
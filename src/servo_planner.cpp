@@ -0,0 +1,73 @@
+/**
+ * @file servo_planner.cpp
+ *
+ * @brief Implementation of the servo trajectory generator defined in servo_planner.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "servo_planner.h"
+#include "params.h"
+
+servoPlanStruct servoPlan;
+
+void initServoPlanner(int angle) {
+	servoPlan.position = angle;
+	servoPlan.velocity = 0;
+	servoPlan.lastUpdateUs = micros();
+}
+
+float servoTrackingSpeed(float balance) {
+	float speed = SERVO_ERROR_GAIN * fabs(balance) * SERVO_MAX_VELOCITY;
+
+	if (speed < SERVO_MIN_VELOCITY)
+		return SERVO_MIN_VELOCITY;
+	if (speed > SERVO_MAX_VELOCITY)
+		return SERVO_MAX_VELOCITY;
+	return speed;
+}
+
+float updateServoPlanner(float targetVelocity) {
+	unsigned long now = micros();
+	float dt = (now - servoPlan.lastUpdateUs) / 1e6;
+	servoPlan.lastUpdateUs = now;
+
+	// Don't lurch after a long stall
+	if (dt > SERVO_MAX_DT_MS / 1000.0)
+		dt = SERVO_MAX_DT_MS / 1000.0;
+
+	if (targetVelocity > SERVO_MAX_VELOCITY)
+		targetVelocity = SERVO_MAX_VELOCITY;
+	if (targetVelocity < -SERVO_MAX_VELOCITY)
+		targetVelocity = -SERVO_MAX_VELOCITY;
+
+	// Accelerate towards the target velocity
+	float maxChange = SERVO_MAX_ACCEL * dt;
+	float change = targetVelocity - servoPlan.velocity;
+	if (change > maxChange)
+		change = maxChange;
+	if (change < -maxChange)
+		change = -maxChange;
+	servoPlan.velocity += change;
+
+	servoPlan.position += servoPlan.velocity * dt;
+
+	// Stop dead at the limits
+	if (servoPlan.position < calibration.servoMin) {
+		servoPlan.position = calibration.servoMin;
+		servoPlan.velocity = 0;
+	} else if (servoPlan.position > calibration.servoMax) {
+		servoPlan.position = calibration.servoMax;
+		servoPlan.velocity = 0;
+	}
+
+	return servoPlan.position;
+}
+
+uint16_t servoAngleToPulse(float angle) {
+	return SERVO_PULSE_MIN + (uint16_t) (angle * (SERVO_PULSE_MAX - SERVO_PULSE_MIN) / 180 + 0.5);
+}
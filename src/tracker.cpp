@@ -0,0 +1,112 @@
+/**
+ * @file tracker.cpp
+ *
+ * @brief Implementation of the light tracker defined in tracker.h
+ *
+ * Part of the lightTrackingRobot project for the BYU ECEN240 course.
+ *
+ * @author Wesley Campbell
+ * @date 2026-10-18
+ * @version 1.0.0
+ */
+
+#include "tracker.h"
+#include "params.h"
+
+lightTrackerStruct lightTracker;
+
+static bool lightInView() {
+	for (int i = 0; i < NUM_PHOTODIODES; i++) {
+		if (photodiodeVoltages[i] >= PHOTODIODE_VOLTAGE_LIMIT)
+			return true;
+	}
+	return false;
+}
+
+static void startAxis(trackerAxisStruct* axis, float measured) {
+	axis->angle = measured;
+	axis->rate = 0;
+}
+
+static void updateAxis(trackerAxisStruct* axis, float measured, float dt) {
+	float residual = measured - axis->angle;
+
+	axis->angle += TRACKER_ALPHA * residual;
+	axis->rate += TRACKER_BETA * residual / dt;
+
+	if (axis->rate > TRACKER_MAX_RATE)
+		axis->rate = TRACKER_MAX_RATE;
+	if (axis->rate < -TRACKER_MAX_RATE)
+		axis->rate = -TRACKER_MAX_RATE;
+}
+
+uint8_t updateLightTracker(uint8_t state) {
+	unsigned long now = micros();
+	float dt = (now - lightTracker.lastUpdateUs) / 1e6;
+	lightTracker.lastUpdateUs = now;
+
+	bool inView = lightInView();
+	float bearing = TRACKER_DEG_PER_BALANCE * lightHorizontalBalance();
+	float elevation = servoPlan.position + TRACKER_DEG_PER_BALANCE * lightVerticalBalance();
+
+	if (state == TRACK_NONE) {
+		if (!inView)
+			return TRACK_NONE;
+
+		startAxis(&lightTracker.bearing, bearing);
+		startAxis(&lightTracker.elevation, elevation);
+		lightTracker.lastSeenUs = now;
+		lightTracker.loopUs = 0;
+		return TRACK_LOCKED;
+	}
+
+	// Don't lurch after a long stall, e.g. idle sleep
+	if (dt > TRACKER_MAX_DT_MS / 1000.0)
+		dt = TRACKER_MAX_DT_MS / 1000.0;
+	if (dt <= 0)
+		return state;
+	// Start the filter from the first period rather than from 0
+	if (lightTracker.loopUs == 0)
+		lightTracker.loopUs = dt * 1e6;
+	else
+		lightTracker.loopUs += TRACKER_LOOP_FILTER * (dt * 1e6 - lightTracker.loopUs);
+
+	// Predict
+	lightTracker.bearing.angle += lightTracker.bearing.rate * dt;
+	lightTracker.elevation.angle += lightTracker.elevation.rate * dt;
+
+	if (!inView) {
+		if (now - lightTracker.lastSeenUs >= TRACKER_COAST_MS * 1000UL)
+			return TRACK_NONE;
+		return TRACK_COASTING;
+	}
+
+	// Correct
+	updateAxis(&lightTracker.bearing, bearing, dt);
+	updateAxis(&lightTracker.elevation, elevation, dt);
+	lightTracker.lastSeenUs = now;
+	return TRACK_LOCKED;
+}
+
+float trackerLead() {
+	return lightTracker.loopUs / 1e6 + TRACKER_ACTUATOR_LAG_MS / 1000.0;
+}
+
+float predictedBearing() {
+	return lightTracker.bearing.angle + lightTracker.bearing.rate * trackerLead();
+}
+
+bool trackerLeadsServo() {
+	// Not timed yet on the pass that locks on
+	return lightTracker.loopUs > 0 && lightTracker.loopUs <= TRACKER_SERVO_MAX_LOOP_MS * 1000.0;
+}
+
+float trackerServoVelocity(float position) {
+	float target = lightTracker.elevation.angle + lightTracker.elevation.rate * trackerLead();
+	float error = target - position;
+
+	// Close enough, just keep up with the light, or let the servo rest if it has stopped
+	if (fabs(error) < TRACKER_SERVO_DEADBAND)
+		return (fabs(lightTracker.elevation.rate) < TRACKER_SERVO_DEADBAND) ? 0 : lightTracker.elevation.rate;
+	return lightTracker.elevation.rate + TRACKER_SERVO_GAIN * error;
+}